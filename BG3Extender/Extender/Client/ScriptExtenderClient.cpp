@@ -266,6 +266,9 @@ void ScriptExtender::OnUpdate(void* self, GameTime* time)
 			gExtender->GetLuaDebugger()->ClientTick();
 		}
 	}
+
+	// Strings replaced during the previous tick are no longer referenced by UI reads of that tick
+	GetTranslatedStringOverlay().ReleaseRetired();
 }
 
 void ScriptExtender::OnIncLocalProgress(void* self, int progress, char const* state)
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include <Extender/ScriptExtender.h>
 #include <Extender/Shared/Console.h>
+#include <Extender/Shared/ScriptHelpers.h>
 #include "Version.h"
 #include "resource.h"
 #include <iomanip>
@@ -125,6 +126,7 @@ void ScriptExtender::Shutdown()
 	server_.Shutdown();
 	client_.Shutdown();
 	engineHooks_.UnhookAll();
+	script::GetExternalFileWriter().Shutdown();
 }
 
 void ScriptExtender::LogLuaError(std::string_view msg)
@@ -239,7 +241,7 @@ void ScriptExtender::OnECSUpdate(ecs::EntityWorld::UpdateProc* wrapped, ecs::Ent
 	}
 }
 
-bool ScriptExtender::HasFeatureFlag(char const * flag) const
+bool ScriptExtender::HasFeatureFlag(ExtensionFeatureFlag flag) const
 {
 	return (server_.HasExtensionState() && server_.GetExtensionState().HasFeatureFlag(flag))
 		|| (client_.HasExtensionState() && client_.GetExtensionState().HasFeatureFlag(flag));
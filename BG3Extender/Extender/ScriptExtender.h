@@ -84,7 +84,7 @@ public:
 
 	ExtensionStateBase* GetCurrentExtensionState();
 
-	bool HasFeatureFlag(char const *) const;
+	bool HasFeatureFlag(ExtensionFeatureFlag flag) const;
 
 	inline stats::StatLoadOrderHelper& GetStatLoadOrderHelper()
 	{
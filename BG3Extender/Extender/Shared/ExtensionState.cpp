@@ -2,15 +2,16 @@
 #include <Extender/ScriptExtender.h>
 #include <Extender/Shared/ExtensionState.h>
 #include <Extender/Version.h>
+#include <Extender/Shared/ScriptPreloader.inl>
 #include <fstream>
 #include "json/json.h"
 
 namespace bg3se
 {
-	std::unordered_set<std::string_view> ExtensionStateBase::sAllFeatureFlags = {
-		"Osiris",
-		"Lua",
-		"Preprocessor"
+	std::unordered_map<std::string_view, ExtensionFeatureFlag> ExtensionStateBase::sAllFeatureFlags = {
+		{ "Osiris", ExtensionFeatureFlag::Osiris },
+		{ "Lua", ExtensionFeatureFlag::Lua },
+		{ "Preprocessor", ExtensionFeatureFlag::Preprocessor }
 	};
 
 	char const* sContextNames[] = {
@@ -42,6 +43,8 @@ namespace bg3se
 
 	void ExtensionStateBase::LoadConfigs()
 	{
+		InvalidateModIndex();
+
 		auto modManager = GetModManager();
 		if (modManager == nullptr) {
 			OsiErrorS("Mod manager not available");
@@ -90,6 +93,8 @@ namespace bg3se
 						MergedConfig.FeatureFlags.insert(flag);
 					}
 
+					MergedConfig.FeatureFlagMask |= config.FeatureFlagMask;
+
 					numConfigs++;
 
 					modConfigs_.insert(std::make_pair(mod.Info.ModuleUUIDString.GetString(), config));
@@ -97,6 +102,8 @@ namespace bg3se
 			}
 		}
 
+		BuildLuaModList(*modManager);
+
 		if (numConfigs > 0) {
 			INFO("%d mod configuration(s) loaded.", numConfigs);
 			std::stringstream featureFlags;
@@ -190,8 +197,10 @@ namespace bg3se
 			for (auto const & flag : featureFlags) {
 				if (flag.isString()) {
 					auto flagStr = flag.asString();
-					if (sAllFeatureFlags.find(flagStr) != sAllFeatureFlags.end()) {
+					auto flagIt = sAllFeatureFlags.find(flagStr);
+					if (flagIt != sAllFeatureFlags.end()) {
 						config.FeatureFlags.insert(STDString(flagStr));
+						config.FeatureFlagMask |= (uint32_t)flagIt->second;
 					} else {
 						ERR("Feature flag '%s' not supported!", flagStr.c_str());
 					}
@@ -204,9 +213,46 @@ namespace bg3se
 		return true;
 	}
 
-	bool ExtensionStateBase::HasFeatureFlag(char const * flag) const
+	bool ExtensionStateBase::HasFeatureFlag(ExtensionFeatureFlag flag) const
 	{
-		return MergedConfig.FeatureFlags.find(flag) != MergedConfig.FeatureFlags.end();
+		return MergedConfig.HasFeatureFlag(flag);
+	}
+
+	void ExtensionStateBase::BuildLuaModList(ModManager const& modManager)
+	{
+		auto const& modules = modManager.BaseModule.LoadOrderedModules;
+		luaMods_.Mods.clear();
+		luaMods_.Modules = modules.raw_buf();
+		luaMods_.LoadOrder.clear();
+		for (auto const& mod : modules) {
+			luaMods_.LoadOrder.push_back(mod.Info.ModuleUUID);
+			auto configIt = modConfigs_.find(mod.Info.ModuleUUIDString);
+			if (configIt != modConfigs_.end() && configIt->second.HasFeatureFlag(ExtensionFeatureFlag::Lua)) {
+				luaMods_.Mods.push_back(LuaModEntry{
+					&mod,
+					&configIt->second,
+					ResolveModScriptPath(mod, GetBootstrapFileName()),
+					ResolveModScriptPath(mod, "BootstrapModule.lua")
+				});
+			}
+		}
+	}
+
+	std::vector<ExtensionStateBase::LuaModEntry> const& ExtensionStateBase::GetLuaMods(ModManager const& modManager)
+	{
+		// Entries point into the load order array, so reallocating it or replacing
+		// modules in place both require a rebuild
+		auto const& modules = modManager.BaseModule.LoadOrderedModules;
+		bool changed = (luaMods_.Modules != modules.raw_buf() || luaMods_.LoadOrder.size() != modules.size());
+		for (uint32_t i = 0; !changed && i < modules.size(); i++) {
+			changed = (luaMods_.LoadOrder[i] != modules[i].Info.ModuleUUID);
+		}
+
+		if (changed) {
+			BuildLuaModList(modManager);
+		}
+
+		return luaMods_.Mods;
 	}
 
 	void ExtensionStateBase::OnGameSessionLoading()
@@ -227,8 +273,75 @@ namespace bg3se
 		}
 	}
 
+	void ExtensionStateBase::InvalidateModIndex()
+	{
+		modIndex_.Valid = false;
+	}
+
+	ExtensionStateBase::ModIndex* ExtensionStateBase::UpdateModIndex()
+	{
+		auto modManager = GetModManager();
+		if (modManager == nullptr) {
+			return nullptr;
+		}
+
+		// The load order may also be modified in place, so the indexed UUIDs are compared as well
+		auto const& modules = modManager->BaseModule.LoadOrderedModules;
+		bool valid = modIndex_.Valid
+			&& modIndex_.Manager == modManager
+			&& modIndex_.Modules == modules.raw_buf()
+			&& modIndex_.NumModules == modules.size();
+		for (uint32_t i = 0; valid && i < modules.size(); i++) {
+			valid = (modIndex_.LoadOrder[i] == modules[i].Info.ModuleUUID);
+		}
+
+		if (valid) {
+			return &modIndex_;
+		}
+
+		modIndex_.ModsByUuid.clear();
+		modIndex_.LoadOrder.clear();
+		for (uint32_t i = 0; i < modules.size(); i++) {
+			modIndex_.ModsByUuid.Set(modules[i].Info.ModuleUUID, i);
+			modIndex_.LoadOrder.Add(modules[i].Info.ModuleUUID);
+		}
+
+		modIndex_.Manager = modManager;
+		modIndex_.Modules = modules.raw_buf();
+		modIndex_.NumModules = modules.size();
+		modIndex_.Valid = true;
+		return &modIndex_;
+	}
+
+	Module* ExtensionStateBase::GetLoadedMod(Guid const& modUuid)
+	{
+		auto index = UpdateModIndex();
+		if (index == nullptr) {
+			return nullptr;
+		}
+
+		auto modIndex = index->ModsByUuid.Find(modUuid);
+		if (modIndex) {
+			return &GetModManager()->BaseModule.LoadOrderedModules[**modIndex];
+		} else {
+			return nullptr;
+		}
+	}
+
+	ObjectSet<Guid> const& ExtensionStateBase::GetLoadOrder()
+	{
+		auto index = UpdateModIndex();
+		if (index == nullptr) {
+			static ObjectSet<Guid> emptyLoadOrder;
+			return emptyLoadOrder;
+		}
+
+		return index->LoadOrder;
+	}
+
 	void ExtensionStateBase::OnModuleLoadStarted()
 	{
+		InvalidateModIndex();
 		LuaVirtualPin lua(*this);
 		if (lua) {
 			lua->OnModuleLoadStarted();
@@ -337,6 +450,17 @@ namespace bg3se
 		return path;
 	}
 
+	STDString ExtensionStateBase::GetModScriptName(Module const& mod, STDString const& fileName)
+	{
+		STDString scriptName = mod.Info.Directory;
+		if (scriptName.length() > 37) {
+			// Strip GUID from end of dir
+			scriptName = scriptName.substr(0, scriptName.length() - 37);
+		}
+		scriptName += "/" + fileName;
+		return scriptName;
+	}
+
 	std::optional<int> ExtensionStateBase::LuaLoadExternalFile(STDString const & path)
 	{
 		std::ifstream f(path.c_str(), std::ios::in | std::ios::binary);
@@ -377,22 +501,54 @@ namespace bg3se
 		return lua->LoadScript(reader.ToString(), scriptName, globalsIdx);
 	}
 
+	std::optional<int> ExtensionStateBase::LuaLoadPreloadedFile(ScriptPreloader::Script const& script, STDString const& scriptName, int globalsIdx)
+	{
+		LuaVirtualPin lua(*this);
+		if (!lua) {
+			OsiErrorS("Called when the Lua VM has not been initialized!");
+			return {};
+		}
+
+		// Scripts that failed to compile are loaded from source to report the error the usual way
+		if (script.Compiled) {
+			return lua->LoadCompiledScript(script.Bytecode, scriptName, globalsIdx);
+		} else {
+			return lua->LoadScript(script.Source, scriptName, globalsIdx);
+		}
+	}
+
 	std::optional<int> ExtensionStateBase::LuaLoadGameFile(STDString const & path, STDString const & scriptName, 
 		bool warnOnError, int globalsIdx)
 	{
-		auto reader = GetStaticSymbols().MakeFileReader(path);
-		if (!reader.IsLoaded()) {
-			if (warnOnError) {
-				OsiError("Script file could not be opened: " << path);
+		auto preloaded = scriptPreloader_ ? scriptPreloader_->Get(path) : nullptr;
+		std::optional<FileReaderPin> reader;
+		if (preloaded) {
+			if (!preloaded->Exists) {
+				if (warnOnError) {
+					OsiError("Script file could not be opened: " << path);
+				}
+				return {};
+			}
+		} else {
+			reader.emplace(GetStaticSymbols().MakeFileReader(path));
+			if (!reader->IsLoaded()) {
+				if (warnOnError) {
+					OsiError("Script file could not be opened: " << path);
+				}
+				return {};
 			}
-			return {};
 		}
 
 		loadedFiles_.insert(std::make_pair(scriptName, path));
 		auto fullPath = GetStaticSymbols().ToPath(path, PathRootType::Data);
 		loadedFileFullPaths_.insert(std::make_pair(scriptName, fullPath));
 
-		auto result = LuaLoadGameFile(reader, scriptName.empty() ? path : scriptName, globalsIdx);
+		std::optional<int> result;
+		if (preloaded) {
+			result = LuaLoadPreloadedFile(*preloaded, scriptName.empty() ? path : scriptName, globalsIdx);
+		} else {
+			result = LuaLoadGameFile(*reader, scriptName.empty() ? path : scriptName, globalsIdx);
+		}
 
 		if (!result) {
 			auto it = loadedFiles_.find(scriptName);
@@ -419,20 +575,14 @@ namespace bg3se
 		}
 
 		auto path = ResolveModScriptPath(*mod, fileName);
-
-		STDString scriptName = mod->Info.Directory;
-		if (scriptName.length() > 37) {
-			// Strip GUID from end of dir
-			scriptName = scriptName.substr(0, scriptName.length() - 37);
-		}
-		scriptName += "/" + fileName;
-
+		auto scriptName = GetModScriptName(*mod, fileName);
 		return LuaLoadGameFile(path, scriptName, warnOnError, globalsIdx);
 	}
 
 	std::optional<int> ExtensionStateBase::LuaLoadBuiltinFile(STDString const & path, bool warnOnError, int globalsIdx)
 	{
-		auto file = gExtender->GetLuaBuiltinBundle().GetResource(path);
+		auto& bundle = gExtender->GetLuaBuiltinBundle();
+		auto file = bundle.GetResource(path);
 		if (!file) {
 			if (warnOnError) {
 				OsiError("Builtin Lua script file could not be opened: " << path);
@@ -447,7 +597,7 @@ namespace bg3se
 		}
 
 		auto scriptName = STDString("builtin://") + path;
-		return lua->LoadScript(*file, scriptName, globalsIdx);
+		return lua->LoadBuiltinScript(bundle, path, *file, scriptName, globalsIdx);
 	}
 
 	std::optional<int> ExtensionStateBase::LuaLoadFile(STDString const & path, STDString const & scriptName, 
@@ -516,69 +666,84 @@ namespace bg3se
 			return;
 		}
 
+		// Compile bootstrap scripts (and the scripts they require) in the background while the
+		// bootstraps of earlier mods are running; workers are started first, so that compilation
+		// overlaps with reading the remaining bootstraps
+		auto const& luaMods = GetLuaMods(*modManager);
+		scriptPreloader_ = std::make_unique<ScriptPreloader>(*this);
+		auto numThreads = std::thread::hardware_concurrency();
+		scriptPreloader_->Start(std::clamp(numThreads > 1 ? numThreads - 1 : 1, 1u, 4u));
+
+		for (auto const& mod : luaMods) {
+			if (context_ == ExtensionStateContext::Game) {
+				scriptPreloader_->Enqueue(*mod.Mod, GetBootstrapFileName(), mod.BootstrapPath);
+			} else if (context_ == ExtensionStateContext::Load) {
+				scriptPreloader_->Enqueue(*mod.Mod, "BootstrapModule.lua", mod.PreinitBootstrapPath);
+			}
+		}
+
 		lua::Restriction restriction(*lua, lua::State::RestrictAll);
-		for (auto const& mod : modManager->BaseModule.LoadOrderedModules) {
-			auto configIt = modConfigs_.find(mod.Info.ModuleUUIDString);
-			if (configIt != modConfigs_.end()) {
-				auto const & config = configIt->second;
-				if (config.FeatureFlags.find("Lua") != config.FeatureFlags.end()) {
-					if (gExtender->GetClient().IsInClientThread()) {
-						gExtender->GetClient().UpdateClientProgress(mod.Info.Name);
-					} else {
-						gExtender->GetClient().UpdateServerProgress(mod.Info.Name);
-					}
+		for (auto const& mod : luaMods) {
+			if (gExtender->GetClient().IsInClientThread()) {
+				gExtender->GetClient().UpdateClientProgress(mod.Mod->Info.Name);
+			} else {
+				gExtender->GetClient().UpdateServerProgress(mod.Mod->Info.Name);
+			}
 
-					if (context_ == ExtensionStateContext::Game) {
-						LuaLoadGameBootstrap(config, mod);
-					} else if (context_ == ExtensionStateContext::Load) {
-						LuaLoadPreinitBootstrap(config, mod);
-					} else {
-						ERR("Bootstrap request with Uninitialized extension context?");
-					}
-				}
+			if (context_ == ExtensionStateContext::Game) {
+				LuaLoadGameBootstrap(mod);
+			} else if (context_ == ExtensionStateContext::Load) {
+				LuaLoadPreinitBootstrap(mod);
+			} else {
+				ERR("Bootstrap request with Uninitialized extension context?");
 			}
 		}
 
+		scriptPreloader_.reset();
 		lua->FinishStartup();
 	}
 
-	void ExtensionStateBase::LuaLoadGameBootstrap(ExtensionModConfig const& config, Module const& mod)
+	bool ExtensionStateBase::BootstrapFileExists(STDString const& path)
 	{
-		auto bootstrapFileName = GetBootstrapFileName();
-		auto const& sym = GetStaticSymbols();
+		auto preloaded = scriptPreloader_ ? scriptPreloader_->Get(path) : nullptr;
+		if (preloaded) {
+			return preloaded->Exists;
+		} else {
+			return GetStaticSymbols().FileExists(path);
+		}
+	}
 
-		auto bootstrapPath = ResolveModScriptPath(mod, bootstrapFileName);
-		if (!bootstrapPath.empty() && sym.FileExists(bootstrapPath)) {
+	void ExtensionStateBase::LuaLoadGameBootstrap(LuaModEntry const& mod)
+	{
+		auto const& bootstrapPath = mod.BootstrapPath;
+		if (!bootstrapPath.empty() && BootstrapFileExists(bootstrapPath)) {
 			LuaVirtualPin lua(*this);
 			auto L = lua->GetState();
-			lua::push(L, mod.Info.ModuleUUIDString);
+			lua::push(L, mod.Mod->Info.ModuleUUIDString);
 			lua_setglobal(L, "ModuleUUID");
 
 			OsiMsg("Loading bootstrap script: " << bootstrapPath);
-			lua->LoadBootstrap(bootstrapFileName, config.ModTable);
+			lua->LoadBootstrap(GetBootstrapFileName(), mod.Config->ModTable);
 
 			lua::push(L, nullptr);
 			lua_setglobal(L, "ModuleUUID");
 		}
 	}
 
-	void ExtensionStateBase::LuaLoadPreinitBootstrap(ExtensionModConfig const& config, Module const& mod)
+	void ExtensionStateBase::LuaLoadPreinitBootstrap(LuaModEntry const& mod)
 	{
-		auto bootstrapFileName = "BootstrapModule.lua";
-		auto const& sym = GetStaticSymbols();
-
-		auto path = ResolveModScriptPath(mod, bootstrapFileName);
-		if (!sym.FileExists(path)) {
+		auto const& path = mod.PreinitBootstrapPath;
+		if (!BootstrapFileExists(path)) {
 			return;
 		}
 
 		LuaVirtualPin lua(*this);
 		auto L = lua->GetState();
-		lua::push(L, mod.Info.ModuleUUID);
+		lua::push(L, mod.Mod->Info.ModuleUUID);
 		lua_setglobal(L, "ModuleUUID");
 
 		OsiMsg("Loading preinit bootstrap script: " << path);
-		lua->LoadBootstrap(bootstrapFileName, config.ModTable);
+		lua->LoadBootstrap("BootstrapModule.lua", mod.Config->ModTable);
 
 		lua::push(L, nullptr);
 		lua_setglobal(L, "ModuleUUID");
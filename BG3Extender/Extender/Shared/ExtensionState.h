@@ -2,6 +2,7 @@
 
 #include "ExtensionHelpers.h"
 #include "Lua/LuaBinding.h"
+#include "ScriptPreloader.h"
 #include <random>
 #include <unordered_set>
 
@@ -11,12 +12,26 @@ namespace bg3se
 {
 	class FileReaderPin;
 
+	enum class ExtensionFeatureFlag : uint32_t
+	{
+		Osiris = 1 << 0,
+		Lua = 1 << 1,
+		Preprocessor = 1 << 2
+	};
+
 	struct ExtensionModConfig
 	{
 		uint32_t MinimumVersion{ 0 };
 		// Name to use in Lua Mods global table (>= v43)
 		STDString ModTable;
 		std::unordered_set<STDString> FeatureFlags;
+		// Bitmask of ExtensionFeatureFlag values; same flags as FeatureFlags
+		uint32_t FeatureFlagMask{ 0 };
+
+		inline bool HasFeatureFlag(ExtensionFeatureFlag flag) const
+		{
+			return (FeatureFlagMask & (uint32_t)flag) != 0;
+		}
 	};
 
 	enum class ExtensionStateContext
@@ -49,7 +64,11 @@ namespace bg3se
 		void LoadConfigs();
 		bool LoadConfig(Module const & mod, STDString const & configText, ExtensionModConfig & config);
 		bool LoadConfig(Module const & mod, Json::Value & json, ExtensionModConfig & config);
-		bool HasFeatureFlag(char const * flag) const;
+		bool HasFeatureFlag(ExtensionFeatureFlag flag) const;
+
+		Module* GetLoadedMod(Guid const& modUuid);
+		ObjectSet<Guid> const& GetLoadOrder();
+		void InvalidateModIndex();
 
 		inline ExtensionStateContext Context() const
 		{
@@ -77,6 +96,8 @@ namespace bg3se
 
 		std::optional<STDString> ResolveModScriptPath(STDString const& modNameGuid, STDString const& fileName);
 		STDString ResolveModScriptPath(Module const& mod, STDString const& fileName);
+		// Chunk name used for mod scripts (mod directory without the GUID suffix + file name)
+		STDString GetModScriptName(Module const& mod, STDString const& fileName);
 
 		std::optional<int> LuaLoadExternalFile(STDString const & path);
 		std::optional<int> LuaLoadGameFile(FileReaderPin & reader, STDString const & scriptName, int globalsIdx = 0);
@@ -114,11 +135,44 @@ namespace bg3se
 
 	protected:
 		friend class LuaVirtualPin;
-		static std::unordered_set<std::string_view> sAllFeatureFlags;
+		static std::unordered_map<std::string_view, ExtensionFeatureFlag> sAllFeatureFlags;
+
+		// Lookup tables for the loaded mod list.
+		// Rebuilt on module load and whenever the load order of the mod manager changes.
+		struct ModIndex
+		{
+			ModManager const* Manager{ nullptr };
+			Module const* Modules{ nullptr };
+			uint32_t NumModules{ 0 };
+			bool Valid{ false };
+			// Index of each mod in ModManager::BaseModule::LoadOrderedModules
+			MultiHashMap<Guid, uint32_t> ModsByUuid;
+			ObjectSet<Guid> LoadOrder;
+		};
+
+		// Lua-enabled mod with its bootstrap paths resolved
+		struct LuaModEntry
+		{
+			Module const* Mod;
+			ExtensionModConfig const* Config;
+			STDString BootstrapPath;
+			STDString PreinitBootstrapPath;
+		};
+
+		// Lua-enabled mods in load order; built when configs are loaded and rebuilt if
+		// the load order of the mod manager changes
+		struct LuaModList
+		{
+			// Load order array and module UUIDs the list was built from
+			Module const* Modules{ nullptr };
+			std::vector<Guid> LoadOrder;
+			std::vector<LuaModEntry> Mods;
+		};
 
 		ExtensionModConfig MergedConfig;
 		Module const* HighestVersionMod{ nullptr };
 		std::unordered_map<FixedString, ExtensionModConfig> modConfigs_;
+		LuaModList luaMods_;
 
 		std::recursive_mutex luaMutex_;
 		std::atomic<uint32_t> luaRefs_{ 0 };
@@ -135,12 +189,20 @@ namespace bg3se
 
 		UserVariableManager userVariables_;
 		ModVariableManager modVariables_;
+		ModIndex modIndex_;
+		// Only exists during Lua startup
+		std::unique_ptr<ScriptPreloader> scriptPreloader_;
 
+		ModIndex* UpdateModIndex();
+		void BuildLuaModList(ModManager const& modManager);
+		std::vector<LuaModEntry> const& GetLuaMods(ModManager const& modManager);
 		void LuaResetInternal();
 		virtual void DoLuaReset() = 0;
 		virtual void LuaStartup();
-		void LuaLoadGameBootstrap(ExtensionModConfig const& config, Module const& mod);
-		void LuaLoadPreinitBootstrap(ExtensionModConfig const& config, Module const& mod);
+		std::optional<int> LuaLoadPreloadedFile(ScriptPreloader::Script const& script, STDString const& scriptName, int globalsIdx);
+		bool BootstrapFileExists(STDString const& path);
+		void LuaLoadGameBootstrap(LuaModEntry const& mod);
+		void LuaLoadPreinitBootstrap(LuaModEntry const& mod);
 	};
 
 	ExtensionStateBase* GetCurrentExtensionState();
@@ -2,6 +2,7 @@
 #include "ScriptHelpers.h"
 #include <Extender/ScriptExtender.h>
 #include <fstream>
+#include <chrono>
 #include <shlwapi.h>
 
 namespace bg3se::script {
@@ -67,20 +68,140 @@ std::optional<STDString> LoadExternalFile(std::string_view path, PathRootType ro
 		auto absolutePath = GetPathForExternalIo(path, root);
 		if (!absolutePath) return {};
 
-		std::ifstream f(absolutePath->c_str(), std::ios::in | std::ios::binary);
-		if (f.good()) {
-			STDString body;
-			f.seekg(0, std::ios::end);
-			body.resize((unsigned)f.tellg());
-			f.seekg(0, std::ios::beg);
-			f.read(body.data(), body.size());
-			return body;
+		// Saves are performed asynchronously; make sure that scripts see their own writes
+		auto pending = GetExternalFileWriter().GetPendingContents(*absolutePath);
+		if (pending) {
+			return pending;
+		}
+
+		auto loaded = GetExternalFileCache().Load(*absolutePath);
+		if (loaded) {
+			return *loaded->Contents;
 		}
 	}
 
 	return {};
 }
 
+std::optional<uint64_t> LoadExternalFileIfChanged(std::string_view path, PathRootType root, uint64_t knownVersion,
+	std::optional<STDString>& contents)
+{
+	auto absolutePath = GetPathForExternalIo(path, root);
+	if (!absolutePath) return {};
+
+	// Files with queued writes have no stable version yet; always report them as changed
+	auto pending = GetExternalFileWriter().GetPendingContents(*absolutePath);
+	if (pending) {
+		contents = std::move(pending);
+		return 0;
+	}
+
+	auto loaded = GetExternalFileCache().Load(*absolutePath, knownVersion);
+	if (!loaded) return {};
+
+	if (loaded->Contents) {
+		contents = *loaded->Contents;
+	}
+
+	return loaded->Version;
+}
+
+ExternalFileCache& GetExternalFileCache()
+{
+	// Intentionally never destroyed; cached contents are allocated from the game allocator,
+	// which may already be gone when static destructors run
+	static ExternalFileCache* cache = new ExternalFileCache();
+	return *cache;
+}
+
+std::optional<ExternalFileCache::LoadResult> ExternalFileCache::Load(STDWString const& path, uint64_t knownVersion)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attrs;
+	if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attrs)
+		|| (attrs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+		Invalidate(path);
+		return {};
+	}
+
+	auto size = ((uint64_t)attrs.nFileSizeHigh << 32) | attrs.nFileSizeLow;
+	auto modifiedTime = ((uint64_t)attrs.ftLastWriteTime.dwHighDateTime << 32) | attrs.ftLastWriteTime.dwLowDateTime;
+
+	{
+		std::lock_guard _(mutex_);
+		auto it = entries_.find(path);
+		if (it != entries_.end() && it->second.Size == size && it->second.ModifiedTime == modifiedTime) {
+			if (it->second.Version == knownVersion) {
+				return LoadResult{ knownVersion, nullptr };
+			}
+
+			if (it->second.Contents) {
+				return LoadResult{ it->second.Version, it->second.Contents };
+			}
+		}
+	}
+
+	auto contents = ReadStream(path);
+	if (!contents) {
+		return {};
+	}
+
+	std::lock_guard _(mutex_);
+	auto& entry = entries_[path];
+	if (entry.Version == 0 || entry.Size != size || entry.ModifiedTime != modifiedTime) {
+		entry.Size = size;
+		entry.ModifiedTime = modifiedTime;
+		entry.Version = nextVersion_++;
+	}
+
+	if (entry.Contents) {
+		cachedBytes_ -= entry.Contents->size();
+		entry.Contents.reset();
+	}
+
+	if (contents->size() <= MaxCachedFileSize) {
+		if (cachedBytes_ + contents->size() > MaxCacheSize) {
+			// Drop cached contents but keep versions, so LoadExternalFileIfChanged() still works
+			for (auto& it : entries_) {
+				it.second.Contents.reset();
+			}
+			cachedBytes_ = 0;
+		}
+
+		entry.Contents = contents;
+		cachedBytes_ += contents->size();
+	}
+
+	return LoadResult{ entry.Version, contents };
+}
+
+void ExternalFileCache::Invalidate(STDWString const& path)
+{
+	std::lock_guard _(mutex_);
+	auto it = entries_.find(path);
+	if (it != entries_.end()) {
+		if (it->second.Contents) {
+			cachedBytes_ -= it->second.Contents->size();
+		}
+
+		entries_.erase(it);
+	}
+}
+
+std::shared_ptr<STDString const> ExternalFileCache::ReadStream(STDWString const& path)
+{
+	std::ifstream f(path.c_str(), std::ios::in | std::ios::binary);
+	if (!f.good()) {
+		return {};
+	}
+
+	auto body = std::make_shared<STDString>();
+	f.seekg(0, std::ios::end);
+	body->resize((unsigned)f.tellg());
+	f.seekg(0, std::ios::beg);
+	f.read(body->data(), body->size());
+	return body;
+}
+
 bool CreateParentDirectoryRecursive(std::wstring_view path)
 {
 	auto dirEnd = path.find_last_of('/');
@@ -99,11 +220,254 @@ bool CreateParentDirectoryRecursive(std::wstring_view path)
 	if (created == FALSE) {
 		DWORD lastError = GetLastError();
 		if (lastError != ERROR_ALREADY_EXISTS) {
-			OsiError("Could not create storage directory: " << ToUTF8(parentDir));
+			ERR("Could not create storage directory: %s", ToUTF8(parentDir).c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ExternalFileWriter& GetExternalFileWriter()
+{
+	// Intentionally never destroyed; the worker thread is detached on shutdown and may still
+	// be referencing the writer when static destructors run
+	static ExternalFileWriter* writer = new ExternalFileWriter();
+	return *writer;
+}
+
+void ExternalFileWriter::Enqueue(STDWString const& path, std::string_view contents, CompletionHandler handler)
+{
+	std::unique_lock lock(mutex_);
+	if (shutdown_) {
+		lock.unlock();
+		auto succeeded = WriteOnShutdown(path, contents);
+		if (handler) handler(succeeded);
+		return;
+	}
+
+	auto it = pending_.find(path);
+	if (it != pending_.end()) {
+		it->second.Contents = contents;
+		if (handler) it->second.Handlers.push_back(std::move(handler));
+		return;
+	}
+
+	auto& write = pending_.insert(std::make_pair(path, PendingWrite{})).first->second;
+	write.Contents = contents;
+	if (handler) write.Handlers.push_back(std::move(handler));
+	queue_.push_back(path);
+
+	if (!thread_) {
+		thread_ = std::make_unique<std::thread>(&ExternalFileWriter::Run, this);
+	}
+
+	queueChanged_.notify_one();
+}
+
+bool ExternalFileWriter::WriteNow(STDWString const& path, std::string_view contents)
+{
+	std::unique_lock lock(mutex_);
+	if (shutdown_) {
+		lock.unlock();
+		return WriteOnShutdown(path, contents);
+	}
+
+	// A queued write of the same file would replace these contents later, so it is dropped;
+	// its handlers get the result of this write instead
+	std::vector<CompletionHandler> superseded;
+	auto it = pending_.find(path);
+	if (it != pending_.end()) {
+		superseded = std::move(it->second.Handlers);
+		pending_.erase(it);
+		queue_.erase(std::find(queue_.begin(), queue_.end(), path));
+		writeCompleted_.notify_all();
+	}
+
+	// Older contents of the same file that the worker is writing must not land after ours
+	writeCompleted_.wait(lock, [this, &path]() { return shutdown_ || !inFlight_ || inFlightPath_ != path; });
+	lock.unlock();
+
+	auto succeeded = Write(path, contents);
+	for (auto const& handler : superseded) {
+		handler(succeeded);
+	}
+
+	if (!succeeded && !superseded.empty()) {
+		lock.lock();
+		failedSinceFlush_ = true;
+	}
+
+	return succeeded;
+}
+
+std::optional<STDString> ExternalFileWriter::GetPendingContents(STDWString const& path)
+{
+	std::lock_guard _(mutex_);
+	auto it = pending_.find(path);
+	if (it != pending_.end()) {
+		return it->second.Contents;
+	}
+
+	if (inFlight_ && inFlightPath_ == path) {
+		return inFlightContents_;
+	}
+
+	return {};
+}
+
+bool ExternalFileWriter::Flush()
+{
+	std::unique_lock lock(mutex_);
+	writeCompleted_.wait(lock, [this]() { return shutdown_ || (queue_.empty() && !inFlight_); });
+	auto succeeded = !failedSinceFlush_;
+	failedSinceFlush_ = false;
+	return succeeded;
+}
+
+void ExternalFileWriter::Shutdown()
+{
+	std::unique_lock lock(mutex_);
+	shutdown_ = true;
+	queueChanged_.notify_all();
+	writeCompleted_.notify_all();
+
+	// This is called from DllMain, so we can't wait for the worker: joining it or waiting for its
+	// signal could deadlock on the loader lock, and on process exit it may already be terminated.
+	// Drain the queued writes on this thread instead; a write the worker already started is left to it.
+	STDWString path;
+	PendingWrite write;
+	while (TakeNext(path, write)) {
+		lock.unlock();
+		auto succeeded = WriteOnShutdown(path, write.Contents);
+		for (auto const& handler : write.Handlers) {
+			handler(succeeded);
+		}
+		lock.lock();
+		inFlight_ = false;
+	}
+
+	if (thread_) {
+		thread_->detach();
+		thread_.reset();
+	}
+}
+
+void ExternalFileWriter::Run()
+{
+	std::unique_lock lock(mutex_);
+	for (;;) {
+		queueChanged_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+		if (shutdown_) break;
+
+		STDWString path;
+		PendingWrite write;
+		if (!TakeNext(path, write)) continue;
+
+		lock.unlock();
+		auto succeeded = Write(path, write.Contents);
+		for (auto const& handler : write.Handlers) {
+			handler(succeeded);
+		}
+		lock.lock();
+
+		inFlight_ = false;
+		if (!succeeded) {
+			failedSinceFlush_ = true;
+		}
+		writeCompleted_.notify_all();
+	}
+}
+
+bool ExternalFileWriter::TakeNext(STDWString& path, PendingWrite& write)
+{
+	if (queue_.empty()) return false;
+
+	path = std::move(queue_.front());
+	queue_.pop_front();
+	auto it = pending_.find(path);
+	write = std::move(it->second);
+	pending_.erase(it);
+
+	// Keep the contents visible to GetPendingContents() until the file is written
+	inFlight_ = true;
+	inFlightPath_ = path;
+	inFlightContents_ = write.Contents;
+	return true;
+}
+
+bool ExternalFileWriter::Write(STDWString const& path, std::string_view contents)
+{
+	std::lock_guard _(writeMutex_);
+	auto succeeded = CreateParentDirectory(path) && WriteAndRename(path, contents, L".tmp");
+	if (!succeeded) {
+		// The directory might have been removed since we last checked it
+		knownDirectories_.erase(path.substr(0, path.find_last_of(L'/')));
+	}
+
+	GetExternalFileCache().Invalidate(path);
+	return succeeded;
+}
+
+bool ExternalFileWriter::WriteOnShutdown(STDWString const& path, std::string_view contents)
+{
+	std::unique_lock lock(writeMutex_, std::try_to_lock);
+	if (lock.owns_lock()) {
+		lock.unlock();
+		return Write(path, contents);
+	}
+
+	// The worker is (or was, if it was terminated) in the middle of a write; don't wait for it,
+	// and stay clear of its directory cache and temporary file
+	auto succeeded = CreateParentDirectoryRecursive(path) && WriteAndRename(path, contents, L".shutdown.tmp");
+	GetExternalFileCache().Invalidate(path);
+	return succeeded;
+}
+
+bool ExternalFileWriter::CreateParentDirectory(STDWString const& path)
+{
+	auto dirEnd = path.find_last_of(L'/');
+	if (dirEnd == STDWString::npos) return true;
+
+	STDWString parentDir(path.substr(0, dirEnd));
+	if (knownDirectories_.find(parentDir) != knownDirectories_.end()) {
+		return true;
+	}
+
+	if (!CreateParentDirectoryRecursive(path)) {
+		return false;
+	}
+
+	knownDirectories_.insert(parentDir);
+	return true;
+}
+
+bool ExternalFileWriter::WriteAndRename(STDWString const& path, std::string_view contents, wchar_t const* tempSuffix)
+{
+	auto tempPath = path + tempSuffix;
+
+	{
+		std::ofstream f(tempPath.c_str(), std::ios::out | std::ios::binary);
+		if (!f.good()) {
+			ERR("Could not open file for writing: '%s'", ToUTF8(path).c_str());
+			return false;
+		}
+
+		f.write(contents.data(), contents.length());
+		f.close();
+		if (!f.good()) {
+			ERR("Could not write file: '%s'", ToUTF8(path).c_str());
+			DeleteFileW(tempPath.c_str());
 			return false;
 		}
 	}
 
+	if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		ERR("Could not replace file '%s' (error %d)", ToUTF8(path).c_str(), GetLastError());
+		DeleteFileW(tempPath.c_str());
+		return false;
+	}
+
 	return true;
 }
 
@@ -112,16 +476,22 @@ bool SaveExternalFile(std::string_view path, PathRootType root, std::string_view
 	auto absolutePath = GetPathForExternalIo(path, root);
 	if (!absolutePath) return false;
 
-	if (!CreateParentDirectoryRecursive(*absolutePath)) return false;
+	return GetExternalFileWriter().WriteNow(*absolutePath, contents);
+}
 
-	std::ofstream f(absolutePath->c_str(), std::ios::out | std::ios::binary);
-	if (!f.good()) {
-		OsiError("Could not open file for writing: '" << path << "'");
-		return false;
-	}
+bool SaveExternalFileAsync(std::string_view path, PathRootType root, std::string_view contents,
+	ExternalFileWriter::CompletionHandler handler)
+{
+	auto absolutePath = GetPathForExternalIo(path, root);
+	if (!absolutePath) return false;
 
-	f.write(contents.data(), contents.length());
+	GetExternalFileWriter().Enqueue(*absolutePath, contents, std::move(handler));
 	return true;
 }
 
+bool FlushExternalFiles()
+{
+	return GetExternalFileWriter().Flush();
+}
+
 }
@@ -2,12 +2,121 @@
 
 #include <GameDefinitions/Base/Base.h>
 #include <GameDefinitions/Item.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <unordered_set>
 
 namespace bg3se::script {
 
+	// Performs external file writes on a background thread.
+	// Saves to a path that is still waiting in the queue replace the queued contents instead of
+	// writing the file twice. Files are written to a temporary file first that is then renamed
+	// over the target, so a crash during the write never leaves a truncated file behind.
+	class ExternalFileWriter
+	{
+	public:
+		using CompletionHandler = std::function<void(bool succeeded)>;
+
+		void Enqueue(STDWString const& path, std::string_view contents, CompletionHandler handler = {});
+		// Writes a file on the calling thread, superseding any queued write of the same file
+		bool WriteNow(STDWString const& path, std::string_view contents);
+		// Returns the contents of a write that was queued, but hasn't landed on disk yet
+		std::optional<STDString> GetPendingContents(STDWString const& path);
+		// Waits until all queued writes are completed; returns false if any write failed since the last flush
+		bool Flush();
+		void Shutdown();
+
+	private:
+		struct PendingWrite
+		{
+			STDString Contents;
+			std::vector<CompletionHandler> Handlers;
+		};
+
+		std::mutex mutex_;
+		std::condition_variable queueChanged_;
+		std::condition_variable writeCompleted_;
+		std::unordered_map<STDWString, PendingWrite> pending_;
+		std::deque<STDWString> queue_;
+		// Write currently being performed outside of the lock
+		bool inFlight_{ false };
+		STDWString inFlightPath_;
+		STDString inFlightContents_;
+		bool failedSinceFlush_{ false };
+		bool shutdown_{ false };
+		std::unique_ptr<std::thread> thread_;
+
+		// Serializes disk access between the worker thread and writes performed during shutdown
+		std::mutex writeMutex_;
+		std::unordered_set<STDWString> knownDirectories_;
+
+		void Run();
+		bool TakeNext(STDWString& path, PendingWrite& write);
+		bool Write(STDWString const& path, std::string_view contents);
+		// Writes a file without waiting for the worker thread
+		bool WriteOnShutdown(STDWString const& path, std::string_view contents);
+		bool CreateParentDirectory(STDWString const& path);
+		bool WriteAndRename(STDWString const& path, std::string_view contents, wchar_t const* tempSuffix);
+	};
+
+	ExternalFileWriter& GetExternalFileWriter();
+
+	// Caches the contents of external files that are read repeatedly (eg. config files polled by mods).
+	// Entries are revalidated against the size and modification time of the file on each access,
+	// so a cache hit costs a single stat call.
+	class ExternalFileCache
+	{
+	public:
+		struct LoadResult
+		{
+			// Unique version of the file contents; changes each time the file is modified
+			uint64_t Version{ 0 };
+			// File contents; null if the file is still at the version passed to Load()
+			std::shared_ptr<STDString const> Contents;
+		};
+
+		std::optional<LoadResult> Load(STDWString const& path, uint64_t knownVersion = 0);
+		void Invalidate(STDWString const& path);
+
+	private:
+		static constexpr uint64_t MaxCachedFileSize = 0x100000;
+		static constexpr uint64_t MaxCacheSize = 0x1000000;
+
+		struct Entry
+		{
+			uint64_t Size{ 0 };
+			uint64_t ModifiedTime{ 0 };
+			uint64_t Version{ 0 };
+			// Only set for files that fit in the cache; larger files only track their version
+			std::shared_ptr<STDString const> Contents;
+		};
+
+		std::mutex mutex_;
+		std::unordered_map<STDWString, Entry> entries_;
+		uint64_t cachedBytes_{ 0 };
+		uint64_t nextVersion_{ 1 };
+
+		static std::shared_ptr<STDString const> ReadStream(STDWString const& path);
+	};
+
+	ExternalFileCache& GetExternalFileCache();
+
 	std::optional<STDWString> GetPathForExternalIo(std::string_view scriptPath, PathRootType root);
 	std::optional<STDString> LoadExternalFile(std::string_view path, PathRootType root);
+	// Loads a file from the specified root if it was modified since the specified version.
+	// Returns the current version of the file, or std::nullopt if it doesn't exist.
+	std::optional<uint64_t> LoadExternalFileIfChanged(std::string_view path, PathRootType root, uint64_t knownVersion,
+		std::optional<STDString>& contents);
+	// Writes a file on the calling thread; returns whether the write succeeded
 	bool SaveExternalFile(std::string_view path, PathRootType root, std::string_view contents);
+	// Queues a file to be written on the writer thread. Returns false only if the path is invalid;
+	// write errors are logged, passed to the completion handler and reported by FlushExternalFiles().
+	bool SaveExternalFileAsync(std::string_view path, PathRootType root, std::string_view contents,
+		ExternalFileWriter::CompletionHandler handler = {});
+	// Waits until all queued writes are completed; returns false if any write failed since the last flush
+	bool FlushExternalFiles();
 
 	bool GetTranslatedString(char const* handle, STDString& translated);
 	bool GetTranslatedStringFromKey(FixedString const& key, TranslatedString& translated);
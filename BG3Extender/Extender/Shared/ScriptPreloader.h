@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Lua/LuaBinding.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bg3se
+{
+	class ExtensionStateBase;
+
+	// Compiles mod scripts on worker threads during Lua startup, so that the thread running the
+	// bootstraps only has to execute precompiled chunks.
+	// Files are read and their paths resolved on the thread that queues them, as the game file
+	// reader isn't known to be safe to use from other threads; workers only compile.
+	// Besides the queued files, scripts loaded by a literal single-argument Ext.Require("...")
+	// call in a preloaded script (outside of comments and strings) are also queued.
+	// The scripts required by a preloaded script are read when the next script is requested.
+	class ScriptPreloader : Noncopyable<ScriptPreloader>
+	{
+	public:
+		struct Script
+		{
+			bool Exists{ false };
+			bool Compiled{ false };
+			STDString Source;
+			// Compiled chunk, or the parse error if compilation failed
+			STDString Bytecode;
+		};
+
+		ScriptPreloader(ExtensionStateBase& state);
+		~ScriptPreloader();
+
+		// Reads the script and queues it for compilation
+		void Enqueue(Module const& mod, STDString const& fileName, STDString const& path);
+		void Start(unsigned numWorkers);
+		void Stop();
+
+		// Waits until the script at the specified path is preloaded.
+		// Returns null if the path was never queued.
+		std::shared_ptr<Script> Get(STDString const& path);
+
+	private:
+		struct Request
+		{
+			Module const* Mod;
+			STDString FileName;
+			STDString Path;
+			std::shared_ptr<Script> Loaded;
+		};
+
+		struct RequiredFile
+		{
+			Module const* Mod;
+			STDString FileName;
+		};
+
+		ExtensionStateBase& state_;
+		std::mutex mutex_;
+		std::condition_variable queueCv_;
+		std::condition_variable doneCv_;
+		std::deque<Request> queue_;
+		// Preloaded scripts by path; null while the script is still queued or being loaded
+		std::unordered_map<STDString, std::shared_ptr<Script>> scripts_;
+		// Files required by compiled scripts that weren't read yet
+		std::vector<RequiredFile> requiredFiles_;
+		std::vector<std::thread> workers_;
+		bool stopping_{ false };
+
+		void EnqueueRequiredFiles(std::unique_lock<std::mutex>& lock);
+		void WorkerMain();
+		void Compile(Request const& request, lua::ScriptCompiler& compiler, std::vector<STDString>& requiredFiles);
+		static void FindRequires(StringView source, std::vector<STDString>& requiredFiles);
+		static std::size_t ParseRequireCall(StringView source, std::size_t pos, std::vector<STDString>& requiredFiles);
+	};
+}
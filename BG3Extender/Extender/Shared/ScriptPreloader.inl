@@ -0,0 +1,248 @@
+#include <Extender/Shared/ScriptPreloader.h>
+
+namespace bg3se
+{
+	ScriptPreloader::ScriptPreloader(ExtensionStateBase& state)
+		: state_(state)
+	{}
+
+	ScriptPreloader::~ScriptPreloader()
+	{
+		Stop();
+	}
+
+	void ScriptPreloader::Enqueue(Module const& mod, STDString const& fileName, STDString const& path)
+	{
+		{
+			std::lock_guard _(mutex_);
+			if (stopping_ || scripts_.find(path) != scripts_.end()) return;
+			scripts_.insert(std::make_pair(path, std::shared_ptr<Script>()));
+		}
+
+		auto script = std::make_shared<Script>();
+		auto reader = GetStaticSymbols().MakeFileReader(path);
+		if (reader.IsLoaded()) {
+			script->Exists = true;
+			script->Source = reader.ToString();
+		}
+
+		auto exists = script->Exists;
+		{
+			std::lock_guard _(mutex_);
+			if (exists) {
+				queue_.push_back(Request{ &mod, fileName, path, std::move(script) });
+			} else {
+				scripts_[path] = std::move(script);
+			}
+		}
+
+		if (exists) {
+			queueCv_.notify_one();
+		} else {
+			doneCv_.notify_all();
+		}
+	}
+
+	void ScriptPreloader::EnqueueRequiredFiles(std::unique_lock<std::mutex>& lock)
+	{
+		while (!requiredFiles_.empty() && !stopping_) {
+			auto requiredFiles = std::move(requiredFiles_);
+			requiredFiles_.clear();
+
+			lock.unlock();
+			for (auto const& file : requiredFiles) {
+				Enqueue(*file.Mod, file.FileName, state_.ResolveModScriptPath(*file.Mod, file.FileName));
+			}
+			lock.lock();
+		}
+	}
+
+	void ScriptPreloader::Start(unsigned numWorkers)
+	{
+		for (unsigned i = 0; i < numWorkers; i++) {
+			workers_.push_back(std::thread(&ScriptPreloader::WorkerMain, this));
+		}
+	}
+
+	void ScriptPreloader::Stop()
+	{
+		{
+			std::lock_guard _(mutex_);
+			stopping_ = true;
+			queue_.clear();
+		}
+
+		queueCv_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+
+		workers_.clear();
+	}
+
+	std::shared_ptr<ScriptPreloader::Script> ScriptPreloader::Get(STDString const& path)
+	{
+		std::unique_lock lock(mutex_);
+		for (;;) {
+			// Files required by the scripts compiled so far are read here, as this is the thread
+			// that runs the bootstraps; the path may be one of them
+			EnqueueRequiredFiles(lock);
+
+			// Entries may be inserted while we're waiting, so the entry is looked up each time
+			auto it = scripts_.find(path);
+			if (it == scripts_.end()) {
+				return {};
+			}
+
+			if (it->second || stopping_) {
+				return it->second;
+			}
+
+			doneCv_.wait(lock, [&]() { return stopping_ || !requiredFiles_.empty() || scripts_.find(path)->second; });
+		}
+	}
+
+	void ScriptPreloader::WorkerMain()
+	{
+		lua::ScriptCompiler compiler;
+		std::vector<STDString> requiredFiles;
+
+		for (;;) {
+			Request request;
+			{
+				std::unique_lock lock(mutex_);
+				queueCv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+				if (stopping_) return;
+
+				request = std::move(queue_.front());
+				queue_.pop_front();
+			}
+
+			requiredFiles.clear();
+			Compile(request, compiler, requiredFiles);
+
+			{
+				std::lock_guard _(mutex_);
+				scripts_[request.Path] = std::move(request.Loaded);
+				for (auto const& fileName : requiredFiles) {
+					requiredFiles_.push_back(RequiredFile{ request.Mod, fileName });
+				}
+			}
+
+			doneCv_.notify_all();
+		}
+	}
+
+	void ScriptPreloader::Compile(Request const& request, lua::ScriptCompiler& compiler, std::vector<STDString>& requiredFiles)
+	{
+		auto& script = *request.Loaded;
+		script.Compiled = compiler.Compile(script.Source, state_.GetModScriptName(*request.Mod, request.FileName), script.Bytecode);
+		if (script.Compiled) {
+			FindRequires(script.Source, requiredFiles);
+		}
+	}
+
+	inline bool IsLuaIdentifierChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	// Returns the level of the long bracket (eg. 1 for "[=[") that opens at pos, or -1 if there is none
+	inline int GetLuaLongBracketLevel(StringView source, std::size_t pos)
+	{
+		if (pos >= source.size() || source[pos] != '[') return -1;
+
+		int level = 0;
+		for (pos++; pos < source.size() && source[pos] == '='; pos++) {
+			level++;
+		}
+
+		return (pos < source.size() && source[pos] == '[') ? level : -1;
+	}
+
+	// Returns the position after the long string or comment body that opens at pos
+	inline std::size_t SkipLuaLongBracket(StringView source, std::size_t pos, int level)
+	{
+		STDString close = "]";
+		close.append(level, '=');
+		close += "]";
+		auto end = source.find(close, pos + level + 2);
+		return (end == StringView::npos) ? source.size() : end + close.size();
+	}
+
+	// Returns the position after the quoted string that starts at pos
+	inline std::size_t SkipLuaQuotedString(StringView source, std::size_t pos)
+	{
+		auto quote = source[pos++];
+		while (pos < source.size() && source[pos] != quote && source[pos] != '\n') {
+			pos += (source[pos] == '\\') ? 2 : 1;
+		}
+
+		return std::min(pos + 1, source.size());
+	}
+
+	void ScriptPreloader::FindRequires(StringView source, std::vector<STDString>& requiredFiles)
+	{
+		// Skips comments and string literals, so that only actual calls are matched
+		constexpr StringView requireCall = "Ext.Require";
+		std::size_t pos = 0;
+		while (pos < source.size()) {
+			auto c = source[pos];
+			if (c == '-' && pos + 1 < source.size() && source[pos + 1] == '-') {
+				auto level = GetLuaLongBracketLevel(source, pos + 2);
+				if (level >= 0) {
+					pos = SkipLuaLongBracket(source, pos + 2, level);
+				} else {
+					pos = source.find('\n', pos);
+					if (pos == StringView::npos) break;
+				}
+			} else if (c == '"' || c == '\'') {
+				pos = SkipLuaQuotedString(source, pos);
+			} else if (c == '[') {
+				auto level = GetLuaLongBracketLevel(source, pos);
+				pos = (level >= 0) ? SkipLuaLongBracket(source, pos, level) : pos + 1;
+			} else if (IsLuaIdentifierChar(c)) {
+				// Only match Ext at the start of a name that isn't a field of another table
+				bool isField = pos > 0 && (source[pos - 1] == '.' || source[pos - 1] == ':');
+				if (!isField && source.substr(pos, requireCall.size()) == requireCall) {
+					pos = ParseRequireCall(source, pos + requireCall.size(), requiredFiles);
+				} else {
+					while (pos < source.size() && IsLuaIdentifierChar(source[pos])) pos++;
+				}
+			} else {
+				pos++;
+			}
+		}
+	}
+
+	// Parses the arguments of an Ext.Require call that starts at pos.
+	// Returns the position where scanning should continue.
+	std::size_t ScriptPreloader::ParseRequireCall(StringView source, std::size_t pos, std::vector<STDString>& requiredFiles)
+	{
+		auto skipSpaces = [&](std::size_t p) {
+			while (p < source.size() && (source[p] == ' ' || source[p] == '\t')) p++;
+			return p;
+		};
+
+		pos = skipSpaces(pos);
+		if (pos >= source.size() || source[pos] != '(') return pos;
+
+		pos = skipSpaces(pos + 1);
+		if (pos >= source.size() || (source[pos] != '"' && source[pos] != '\'')) return pos;
+
+		auto quote = source[pos];
+		auto end = source.find(quote, pos + 1);
+		if (end == StringView::npos) return source.size();
+
+		// Only the single-argument form refers to a script of the same mod
+		auto next = skipSpaces(end + 1);
+		if (next < source.size() && source[next] == ')') {
+			auto fileName = source.substr(pos + 1, end - pos - 1);
+			if (fileName.find('\\') == StringView::npos) {
+				requiredFiles.push_back(STDString(fileName));
+			}
+		}
+
+		return end + 1;
+	}
+}
@@ -2,6 +2,8 @@
 
 #include <GameDefinitions/Base/Base.h>
 #include <GameDefinitions/Stats/Stats.h>
+#include <atomic>
+#include <mutex>
 #include <shared_mutex>
 
 BEGIN_NS(stats)
@@ -16,7 +18,16 @@ public:
 	void UpdateModDirectoryMap();
 
 	FixedString GetStatsEntryMod(FixedString statId) const;
-	std::vector<Object*> GetStatsLoadedBefore(FixedString modId) const;
+
+	// Incremented each time the stats manager starts (re)loading; objects owned by the
+	// stats manager that were cached in a previous generation may have been freed since.
+	inline uint32_t GetLoadGeneration() const
+	{
+		return loadGeneration_;
+	}
+
+	std::vector<Object*> GetStatsOfType(uint32_t modifierListIndex);
+	std::vector<Object*> GetStatsLoadedBefore(FixedString modId, std::optional<uint32_t> modifierListIndex = {});
 
 private:
 	struct StatsEntryModMapping
@@ -30,6 +41,19 @@ private:
 	std::unordered_map<FixedString, StatsEntryModMapping> statsEntryToModMap_;
 	FixedString statLastTxtMod_;
 	bool loadingStats_{ false };
+	std::atomic<uint32_t> loadGeneration_{ 0 };
+
+	// Stats objects grouped by modifier list and by the mod that added them.
+	// Both store indices into RPGStats::Objects in ascending order; objects created after the
+	// last query are indexed incrementally, as stats are only ever appended to the list.
+	std::mutex statIndexMutex_;
+	RPGStats* indexedStats_{ nullptr };
+	uint32_t numIndexedStats_{ 0 };
+	std::vector<std::vector<uint32_t>> statsByType_;
+	std::unordered_map<FixedString, std::vector<uint32_t>> statsByMod_;
+
+	void InvalidateStatIndex();
+	void UpdateStatIndex(RPGStats* stats);
 };
 
 END_NS()
@@ -6,15 +6,56 @@ BEGIN_NS(stats)
 void StatLoadOrderHelper::OnLoadStarted()
 {
 	loadingStats_ = true;
+	loadGeneration_++;
 	statLastTxtMod_ = FixedString{};
 	statsEntryToModMap_.clear();
 	UpdateModDirectoryMap();
+	InvalidateStatIndex();
 }
 
 void StatLoadOrderHelper::OnLoadFinished()
 {
 	OnStatFileOpened();
 	loadingStats_ = false;
+	InvalidateStatIndex();
+}
+
+void StatLoadOrderHelper::InvalidateStatIndex()
+{
+	std::lock_guard _(statIndexMutex_);
+	indexedStats_ = nullptr;
+	numIndexedStats_ = 0;
+	statsByType_.clear();
+	statsByMod_.clear();
+}
+
+void StatLoadOrderHelper::UpdateStatIndex(RPGStats* stats)
+{
+	auto const& objects = stats->Objects.Primitives;
+	// Mod mappings are still being updated while stats are loading, so don't trust the index
+	// until loading is finished
+	if (indexedStats_ != stats || objects.size() < numIndexedStats_ || loadingStats_) {
+		indexedStats_ = stats;
+		numIndexedStats_ = 0;
+		statsByType_.clear();
+		statsByMod_.clear();
+	}
+
+	for (uint32_t i = numIndexedStats_; i < objects.size(); i++) {
+		auto object = objects[i];
+		if (statsByType_.size() <= object->ModifierListIndex) {
+			statsByType_.resize(object->ModifierListIndex + 1);
+		}
+
+		statsByType_[object->ModifierListIndex].push_back(i);
+
+		auto mod = GetStatsEntryMod(object->Name);
+		if (mod) {
+			statsByMod_[mod].push_back(i);
+		}
+	}
+
+	numIndexedStats_ = objects.size();
 }
 
 void StatLoadOrderHelper::UpdateModDirectoryMap()
@@ -79,15 +120,33 @@ FixedString StatLoadOrderHelper::GetStatsEntryMod(FixedString statId) const
 	}
 }
 
-std::vector<Object*> StatLoadOrderHelper::GetStatsLoadedBefore(FixedString modId) const
+std::vector<Object*> StatLoadOrderHelper::GetStatsOfType(uint32_t modifierListIndex)
 {
-	std::unordered_set<FixedString> modsLoadedBefore;
+	auto stats = GetStaticSymbols().GetStats();
+	std::lock_guard _(statIndexMutex_);
+	UpdateStatIndex(stats);
+
+	std::vector<Object*> objects;
+	if (modifierListIndex < statsByType_.size()) {
+		auto const& indices = statsByType_[modifierListIndex];
+		objects.reserve(indices.size());
+		for (auto index : indices) {
+			objects.push_back(stats->Objects.Primitives[index]);
+		}
+	}
+
+	return objects;
+}
+
+std::vector<Object*> StatLoadOrderHelper::GetStatsLoadedBefore(FixedString modId, std::optional<uint32_t> modifierListIndex)
+{
+	std::vector<FixedString> modsLoadedBefore;
 	auto state = gExtender->GetCurrentExtensionState();
 	if (!state) return {};
 
 	bool modIdFound{ false };
 	for (auto const& mod : state->GetModManager()->BaseModule.LoadOrderedModules) {
-		modsLoadedBefore.insert(mod.Info.ModuleUUIDString);
+		modsLoadedBefore.push_back(mod.Info.ModuleUUIDString);
 		if (mod.Info.ModuleUUIDString == modId) {
 			modIdFound = true;
 			break;
@@ -99,15 +158,31 @@ std::vector<Object*> StatLoadOrderHelper::GetStatsLoadedBefore(FixedString modId
 		return {};
 	}
 
-	std::vector<Object*> statsLoadedBefore;
 	auto stats = GetStaticSymbols().GetStats();
-	for (auto const& object : stats->Objects.Primitives) {
-		auto statEntryMod = GetStatsEntryMod(object->Name);
-		if (statEntryMod && modsLoadedBefore.find(statEntryMod) != modsLoadedBefore.end()) {
-			statsLoadedBefore.push_back(object);
+	std::lock_guard _(statIndexMutex_);
+	UpdateStatIndex(stats);
+
+	std::vector<uint32_t> indices;
+	for (auto const& mod : modsLoadedBefore) {
+		auto modStats = statsByMod_.find(mod);
+		if (modStats == statsByMod_.end()) continue;
+
+		for (auto index : modStats->second) {
+			if (!modifierListIndex || stats->Objects.Primitives[index]->ModifierListIndex == *modifierListIndex) {
+				indices.push_back(index);
+			}
 		}
 	}
 
+	// Return stats in the order they're in the stats manager, not grouped by mod
+	std::sort(indices.begin(), indices.end());
+
+	std::vector<Object*> statsLoadedBefore;
+	statsLoadedBefore.reserve(indices.size());
+	for (auto index : indices) {
+		statsLoadedBefore.push_back(stats->Objects.Primitives[index]);
+	}
+
 	return statsLoadedBefore;
 }
 
@@ -0,0 +1,24 @@
+// Server status classes by StatusType.
+// Statuses with a type that isn't listed here are exposed as the base esv::Status class.
+
+S(DYING, esv::StatusDying)
+S(HEAL, esv::StatusHeal)
+S(KNOCKED_DOWN, esv::StatusKnockedDown)
+S(TELEPORT_FALLING, esv::StatusTeleportFalling)
+S(BOOST, esv::StatusBoost)
+S(REACTION, esv::StatusReaction)
+S(STORY_FROZEN, esv::StatusStoryFrozen)
+S(SNEAKING, esv::StatusSneaking)
+S(UNLOCK, esv::StatusUnlock)
+S(FEAR, esv::StatusFear)
+S(SMELLY, esv::StatusSmelly)
+S(INVISIBLE, esv::StatusInvisible)
+S(ROTATE, esv::StatusRotate)
+S(MATERIAL, esv::StatusMaterial)
+S(CLIMBING, esv::StatusClimbing)
+S(INCAPACITATED, esv::StatusIncapacitated)
+S(INSURFACE, esv::StatusInSurface)
+S(POLYMORPHED, esv::StatusPolymorphed)
+S(EFFECT, esv::StatusEffect)
+S(DEACTIVATED, esv::StatusDeactivated)
+S(DOWNED, esv::StatusDowned)
@@ -596,19 +596,81 @@ std::optional<STDString*> RPGStats::GetConditions(int conditionsId)
 	}
 }
 
+// Index of the RPGStats::Conditions pool by condition text.
+// Stats mods reference the same condition strings from many entries, so looking up an existing
+// condition by comparing it against every string in the pool got slow for large mods.
+// The pool is only appended to while stats are loaded, so new entries are indexed incrementally;
+// the index is rebuilt when stats are reloaded.
+class ConditionsIndex
+{
+public:
+	std::mutex Mutex;
+
+	void Update(RPGStats* stats)
+	{
+		auto generation = gExtender->GetStatLoadOrderHelper().GetLoadGeneration();
+		if (stats_ != stats || loadGeneration_ != generation || numIndexed_ > stats->Conditions.Size()) {
+			conditionsByHash_.clear();
+			stats_ = stats;
+			loadGeneration_ = generation;
+			numIndexed_ = 0;
+		}
+
+		for (; numIndexed_ < stats->Conditions.Size(); numIndexed_++) {
+			if (!Find(stats, stats->Conditions[numIndexed_])) {
+				conditionsByHash_.insert(std::make_pair(Hash(stats->Conditions[numIndexed_]), (int)numIndexed_));
+			}
+		}
+	}
+
+	std::optional<int> Find(RPGStats* stats, STDString const& conditions) const
+	{
+		auto range = conditionsByHash_.equal_range(Hash(conditions));
+		for (auto it = range.first; it != range.second; ++it) {
+			if (stats->Conditions[it->second] == conditions) {
+				return it->second;
+			}
+		}
+
+		return {};
+	}
+
+	void Add(RPGStats* stats, STDString const& conditions)
+	{
+		stats->Conditions.Add(conditions);
+		conditionsByHash_.insert(std::make_pair(Hash(conditions), (int)numIndexed_));
+		numIndexed_++;
+	}
+
+private:
+	RPGStats* stats_{ nullptr };
+	uint32_t loadGeneration_{ 0 };
+	uint32_t numIndexed_{ 0 };
+	std::unordered_multimap<std::size_t, int> conditionsByHash_;
+
+	static std::size_t Hash(STDString const& conditions)
+	{
+		return std::hash<std::string_view>{}(std::string_view(conditions.data(), conditions.size()));
+	}
+};
+
+ConditionsIndex gConditionsIndex;
+
 int RPGStats::GetOrCreateConditions(STDString const& conditions)
 {
 	if (conditions.empty()) {
 		return -1;
 	}
 
-	for (unsigned i = 0; i < Conditions.Size(); i++) {
-		if (Conditions[i] == conditions) {
-			return (int)i;
-		}
+	std::lock_guard _(gConditionsIndex.Mutex);
+	gConditionsIndex.Update(this);
+
+	auto index = gConditionsIndex.Find(this, conditions);
+	if (index) {
+		return *index;
 	}
 
-	Conditions.Add(conditions);
+	gConditionsIndex.Add(this, conditions);
 	return (int)Conditions.Size() - 1;
 }
 
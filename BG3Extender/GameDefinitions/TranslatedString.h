@@ -141,4 +141,38 @@ struct TranslatedStringRepository : public ProtectedGameObject<TranslatedStringR
 	void UpdateTranslatedString(RuntimeStringHandle const& handle, StringView translated);
 };
 
+// Storage for translated strings added or replaced by the extender.
+// Strings are owned by the overlay (not the game text pool) and are immutable once added.
+// The game text pool and callers of Get() keep views of them without holding the overlay lock,
+// so replaced strings are retired instead of freed, and are only released by the second
+// ReleaseRetired() call (i.e. client tick) after the replacement, when readers are done with them.
+// Lookups take a shared lock on one of the shards; the overlay is not lock-free.
+class TranslatedStringOverlay
+{
+public:
+	std::optional<StringView> Get(RuntimeStringHandle const& handle);
+	void Set(TranslatedStringRepository& repo, RuntimeStringHandle const& handle, StringView translated);
+	// Frees the strings that were replaced before the previous call
+	void ReleaseRetired();
+
+private:
+	static constexpr unsigned NumShards = 16;
+
+	struct Shard
+	{
+		std::shared_mutex Lock;
+		std::unordered_map<FixedString, std::unique_ptr<STDString>> Texts;
+		// Strings replaced since the last ReleaseRetired() call
+		std::vector<std::unique_ptr<STDString>> Retired;
+		// Strings replaced before the last ReleaseRetired() call; freed by the next one
+		std::vector<std::unique_ptr<STDString>> Expiring;
+	};
+
+	std::array<Shard, NumShards> shards_;
+
+	Shard& GetShard(FixedString const& handle);
+};
+
+TranslatedStringOverlay& GetTranslatedStringOverlay();
+
 END_SE()
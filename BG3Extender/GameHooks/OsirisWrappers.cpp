@@ -156,14 +156,14 @@ bool OsirisWrappers::CallWrapper(uint32_t FunctionId, OsiArgumentDesc * Params)
 	auto& osi = gExtender->GetServer().Osiris();
 
 	auto wrappers = osi.GetVMTWrappers();
-	if (wrappers && wrappers->OsirisCallbacksAttachment) {
-		wrappers->OsirisCallbacksAttachment->CallPreHook(FunctionId, Params);
+	if (wrappers && wrappers->GetOsirisCallbacksAttachment()) {
+		wrappers->GetOsirisCallbacksAttachment()->CallPreHook(FunctionId, Params);
 	}
 
 	bool succeeded = gExtender->GetServer().Osiris().GetWrappers().CallOriginal(FunctionId, Params);
 
-	if (wrappers && wrappers->OsirisCallbacksAttachment) {
-		wrappers->OsirisCallbacksAttachment->CallPostHook(FunctionId, Params, succeeded);
+	if (wrappers && wrappers->GetOsirisCallbacksAttachment()) {
+		wrappers->GetOsirisCallbacksAttachment()->CallPostHook(FunctionId, Params, succeeded);
 	}
 
 	return succeeded;
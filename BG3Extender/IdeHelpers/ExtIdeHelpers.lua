@@ -31,6 +31,19 @@ function OsiDatabase:Get(...) end
 --- If the parameter is nil, the column is not filtered (equivalent to passing _ in Osiris). If the parameter is not nil, only rows with matching values will be deleted. 
 --- @vararg OsirisValue|nil
 function OsiDatabase:Delete(...) end
+--- Inserts multiple rows into the database in one call; each row is a table with one value per column.  
+--- The database is looked up by the number of columns in the first row (or by `arity`, if specified).  
+--- Rows are inserted in order; if a row is invalid, rows before it remain inserted.
+--- @param rows table<integer,table<integer,OsirisValue>>
+--- @param arity integer?
+--- @return integer Number of rows processed
+function OsiDatabase:InsertMany(rows, arity) end
+--- Deletes multiple rows from the database in one call. Each row is a filter like the parameters of Delete; nil columns are not filtered.  
+--- Since nil columns at the end of a row don't count towards its length, pass `arity` when the first row ends with a nil column.
+--- @param rows table<integer,table<integer,OsirisValue|nil>>
+--- @param arity integer?
+--- @return integer Number of rows processed
+function OsiDatabase:DeleteMany(rows, arity) end
 
 --- @alias OsiFunction fun(...:OsirisValue):OsirisValue|nil
 --- @alias OsiDynamic table<string, OsiFunction|OsiDatabase>
@@ -8459,13 +8472,20 @@ local Ext_ClientNet = {}
 
 
 --- @class Ext_Debug
+--- @field BenchmarkContainers fun(a1:uint32?):table<string, number>
+--- @field BenchmarkLuaAllocator fun():table<string, number>?
 --- @field Crash fun(a1:int32)
 --- @field DebugBreak fun()
 --- @field DebugDumpLifetimes fun()
 --- @field DumpStack fun()
 --- @field GenerateIdeHelpers fun()
+--- @field GetLuaMemoryStats fun():table<string, number>
+--- @field GetModProfile fun():table<string, table<string, number>>
 --- @field IsDeveloperMode fun():boolean
+--- @field ResetModProfile fun()
 --- @field SetEntityRuntimeCheckLevel fun(a1:int32)
+--- @field SetModQuota fun(a1:string?, a2:number?, a3:number?, a4:boolean?)
+--- @field StartLuaAllocationTrace fun(a1:uint32?)
 local Ext_Debug = {}
 
 
@@ -8476,7 +8496,7 @@ local Ext_Debug = {}
 --- @field GetAllEntitiesWithComponent fun(a1:ExtComponentType):EntityHandle[]
 --- @field GetAllEntitiesWithUuid fun():table<Guid, EntityHandle>
 --- @field HandleToUuid fun(a1:EntityHandle):Guid|nil
---- @field Subscribe fun(a1:ExtComponentType)
+--- @field Subscribe fun(a1:ExtComponentType):uint32
 --- @field Unsubscribe fun(a1:uint32):boolean
 --- @field UuidToHandle fun(a1:Guid):EntityHandle
 local Ext_Entity = {}
@@ -8485,9 +8505,12 @@ local Ext_Entity = {}
 
 --- @class Ext_IO
 --- @field AddPathOverride fun(a1:string, a2:string)
+--- @field Flush fun():boolean
 --- @field GetPathOverride fun(a1:string)
 --- @field LoadFile fun(a1:string, a2:FixedString|nil)
+--- @field LoadFileIfChanged fun(a1:string, a2:int64|nil):string|nil, int64|nil
 --- @field SaveFile fun(a1:string, a2:string):boolean
+--- @field SaveFileAsync fun(a1:string, a2:string):boolean
 local Ext_IO = {}
 
 
@@ -8510,6 +8533,7 @@ local Ext_Json = {}
 --- @class Ext_Loca
 --- @field GetTranslatedString fun(a1:FixedString):string
 --- @field UpdateTranslatedString fun(a1:FixedString, a2:string):boolean
+--- @field UpdateTranslatedStrings fun(a1:table<FixedString, string>):integer
 local Ext_Loca = {}
 
 
@@ -8600,6 +8624,7 @@ local Ext_ServerNet = {}
 --- @field GetLocalTemplate fun(a1:FixedString):GameObjectTemplate
 --- @field GetRootTemplate fun(a1:FixedString):GameObjectTemplate
 --- @field GetTemplate fun(a1:FixedString):GameObjectTemplate
+--- @field GetTemplates fun(a1:FixedString[]):table<FixedString, GameObjectTemplate>
 local Ext_ServerTemplate = {}
 
 
@@ -8620,6 +8645,7 @@ local Ext_StaticData = {}
 --- @field EnumIndexToLabel fun(a1:FixedString, a2:int32):FixedString|nil
 --- @field EnumLabelToIndex fun(a1:FixedString, a2:FixedString)
 --- @field Get fun(a1:string, a2:int32|nil)
+--- @field GetConditionStatistics fun():table
 --- @field GetModifierAttributes fun(a1:FixedString)
 --- @field GetStats fun(a1:FixedString|nil):FixedString[]
 --- @field GetStatsLoadedBefore fun(a1:FixedString, a2:FixedString|nil):FixedString[]
@@ -8671,6 +8697,8 @@ function Ext_Types.GenerateIdeHelpers(outputPath, addOsi) end
 
 
 --- @class Ext_Utils
+--- @field CreateHandleMap fun():EntityHandleMap
+--- @field CreateHandleSet fun(entities:EntityHandle[]|EntityHandleSet|EntityHandleMap|nil):EntityHandleSet
 --- @field GameVersion fun()
 --- @field GetCommandLineParams fun():string[]
 --- @field GetGlobalSwitches fun():GlobalSwitches
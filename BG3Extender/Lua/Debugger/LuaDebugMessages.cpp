@@ -449,7 +449,7 @@ void DebugMessageHandler::HandleRequestSource(uint32_t seq, DbgRequestSource con
 
 void DebugMessageHandler::HandleGetVariables(uint32_t seq, DbgGetVariables const& req)
 {
-	DBGMSG(" --> DbgGetVariables(%d, %d, %d)", req.variableref(), req.frame(), req.local());
+	DBGMSG(" --> DbgGetVariables(%d, %d, %d; %d-%d)", req.variableref(), req.frame(), req.local(), req.start(), req.count());
 
 	if (!debugger_) {
 		WARN("GetVariables: Not attached to story debugger!");
@@ -472,6 +472,10 @@ void DebugMessageHandler::HandleGetVariables(uint32_t seq, DbgGetVariables const
 	varsReq.VariablesRef = req.variableref();
 	varsReq.Frame = req.frame();
 	varsReq.Local = req.local();
+	varsReq.Start = req.start();
+	varsReq.Count = req.count();
+	varsReq.Filter = req.filter();
+	varsReq.CountOnly = req.count_only();
 
 	for (auto const& key : req.key()) {
 		DebuggerGetVariablesRequest::KeyType ele;
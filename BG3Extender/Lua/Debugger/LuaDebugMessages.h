@@ -38,7 +38,7 @@ namespace bg3se::lua::dbg
 	class DebugMessageHandler
 	{
 	public:
-		static const uint32_t ProtocolVersion = 3;
+		static const uint32_t ProtocolVersion = 4;
 
 		DebugMessageHandler(LuaDebugInterface& intf);
 
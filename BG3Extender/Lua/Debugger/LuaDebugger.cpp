@@ -97,6 +97,7 @@ namespace bg3se::lua::dbg
 
 		case LUA_TTABLE:
 			value->set_type_id(MsgValueType::TABLE);
+			value->set_indexed_count((int32_t)lua_rawlen(L, idx));
 			break;
 
 		case LUA_TFUNCTION:
@@ -123,6 +124,9 @@ namespace bg3se::lua::dbg
 			case MetatableTag::ArrayProxy:
 				value->set_type_id(MsgValueType::USERDATA);
 				value->set_stringval(gExtender->GetPropertyMapManager().GetArrayProxy(meta.PropertyMapTag)->GetContainerType().TypeName.GetString());
+				if (meta.Lifetime.IsAlive(L)) {
+					value->set_indexed_count((int32_t)ArrayProxyMetatable::GetImpl(meta)->Length(meta));
+				}
 				break;
 
 			case MetatableTag::MapProxy:
@@ -133,6 +137,9 @@ namespace bg3se::lua::dbg
 			case MetatableTag::SetProxy:
 				value->set_type_id(MsgValueType::USERDATA);
 				value->set_stringval(gExtender->GetPropertyMapManager().GetSetProxy(meta.PropertyMapTag)->GetContainerType().TypeName.GetString());
+				if (meta.Lifetime.IsAlive(L)) {
+					value->set_indexed_count((int32_t)SetProxyMetatable::GetImpl(meta)->Length(meta));
+				}
 				break;
 
 			case MetatableTag::EnumValue:
@@ -303,6 +310,38 @@ namespace bg3se::lua::dbg
 		lua_remove(L, funcIdx);
 	}
 
+	inline bool WantsIndexedChildren(DebuggerGetVariablesRequest const& req)
+	{
+		return req.Filter != DbgGetVariables::NAMED;
+	}
+
+	inline bool WantsNamedChildren(DebuggerGetVariablesRequest const& req)
+	{
+		return req.Filter != DbgGetVariables::INDEXED;
+	}
+
+	// Adds a block of children to the total child count and returns the [first, last) 
+	// range of the block that falls on the page requested by the frontend
+	std::pair<int64_t, int64_t> ReservePageRange(DebuggerGetVariablesRequest const& req, int64_t size)
+	{
+		int64_t base = req.Response->total_count();
+		req.Response->set_total_count((int32_t)(base + size));
+
+		if (req.CountOnly) {
+			return { 0, 0 };
+		}
+
+		auto first = std::clamp<int64_t>(req.Start - base, 0, size);
+		auto last = (req.Count > 0) ? std::clamp<int64_t>(req.Start + req.Count - base, first, size) : size;
+		return { first, last };
+	}
+
+	inline bool IsChildOnPage(DebuggerGetVariablesRequest const& req)
+	{
+		auto range = ReservePageRange(req, 1);
+		return range.first < range.second;
+	}
+
 	void LuaElementToEvalResults(lua_State* L, int keyIndex, int valueIndex, DebuggerGetVariablesRequest const& req)
 	{
 		auto pair = req.Response->add_result();
@@ -341,8 +380,33 @@ namespace bg3se::lua::dbg
 	void LuaTableToEvalResults(lua_State* L, int index, DebuggerGetVariablesRequest const& req)
 	{
 		StackCheck _(L);
-		for (auto idx : iterate(L, index)) {
-			LuaElementToEvalResults(L, -2, -1, req);
+		index = lua_absindex(L, index);
+		auto len = (lua_Integer)lua_rawlen(L, index);
+
+		if (WantsIndexedChildren(req)) {
+			// The sequence part is paged by index, so we don't need to walk the whole table
+			auto page = ReservePageRange(req, len);
+			for (auto i = page.first; i < page.second; i++) {
+				push(L, (lua_Integer)(i + 1));
+				lua_rawgeti(L, index, i + 1);
+				if (lua_type(L, -1) != LUA_TNIL) {
+					LuaElementToEvalResults(L, -2, -1, req);
+				}
+				lua_pop(L, 2);
+			}
+		}
+
+		if (WantsNamedChildren(req)) {
+			for (auto idx : iterate(L, index)) {
+				if (lua_isinteger(L, -2)) {
+					auto key = lua_tointeger(L, -2);
+					if (key >= 1 && key <= len) continue;
+				}
+
+				if (IsChildOnPage(req)) {
+					LuaElementToEvalResults(L, -2, -1, req);
+				}
+			}
 		}
 	}
 
@@ -351,10 +415,14 @@ namespace bg3se::lua::dbg
 		StackCheck _(L);
 		// TODO - liveliness check
 
+		if (!WantsNamedChildren(req)) return;
+
 		auto const& pm = LightObjectProxyByRefMetatable::GetPropertyMap(meta);
 		auto obj = meta.Ptr;
 
 		for (auto const& prop : pm.Properties) {
+			if (!IsChildOnPage(req)) continue;
+
 			auto result = prop.second.Get(L, meta.Lifetime, obj, prop.second);
 			if (result == PropertyOperationResult::Success) {
 				push(L, prop.first);
@@ -371,11 +439,15 @@ namespace bg3se::lua::dbg
 			luaL_error(L, "Attempted to dump dead object of type '%s'", proxy->GetImpl()->GetTypeName().GetString());
 		}
 
+		if (!WantsNamedChildren(req)) return;
+
 		auto const& pm = proxy->GetImpl()->GetPropertyMap();
 		auto obj = proxy->GetImpl()->GetRaw(L);
 		auto lifetime = State::FromLua(L)->GetGlobalLifetime();
 
 		for (auto const& prop : pm.Properties) {
+			if (!IsChildOnPage(req)) continue;
+
 			auto result = prop.second.Get(L, lifetime, obj, prop.second);
 			if (result == PropertyOperationResult::Success) {
 				push(L, prop.first);
@@ -388,10 +460,15 @@ namespace bg3se::lua::dbg
 	void LuaEntityToEvalResults(lua_State* L, int index, CppObjectMetadata& meta, DebuggerGetVariablesRequest const& req)
 	{
 		StackCheck _(L);
+		if (!WantsNamedChildren(req)) return;
+
 		auto entity = EntityProxyMetatable::GetHelper(L, index);
 		auto types = entity.GetAllComponentTypes();
 
-		for (auto type : types) {
+		// Only components on the requested page are fetched
+		auto page = ReservePageRange(req, (int64_t)types.size());
+		for (auto i = page.first; i < page.second; i++) {
+			auto type = types[(uint32_t)i];
 			entity.PushComponentByType(L, type);
 			if (lua_type(L, 1) != LUA_TNIL) {
 				push(L, EnumInfo<ExtComponentType>::Find(type).GetString());
@@ -406,9 +483,11 @@ namespace bg3se::lua::dbg
 	void LuaArrayToEvalResults(lua_State* L, int index, CppObjectMetadata& meta, DebuggerGetVariablesRequest const& req)
 	{
 		StackCheck _(L);
+		if (!WantsIndexedChildren(req)) return;
+
 		auto impl = ArrayProxyMetatable::GetImpl(meta);
-		auto len = impl->Length(meta);
-		for (unsigned i = 1; i <= len; i++) {
+		auto page = ReservePageRange(req, impl->Length(meta));
+		for (auto i = (unsigned)page.first + 1; i <= (unsigned)page.second; i++) {
 			if (impl->GetElement(L, meta, i)) {
 				auto pair = req.Response->add_result();
 				pair->set_type(MsgChildValue::NUMERIC);
@@ -430,11 +509,15 @@ namespace bg3se::lua::dbg
 	void LuaMapToEvalResults(lua_State* L, int index, CppObjectMetadata& meta, DebuggerGetVariablesRequest const& req)
 	{
 		StackCheck _(L);
+		if (!WantsNamedChildren(req)) return;
+
 		auto impl = MapProxyMetatable::GetImpl(meta);
 		push(L, nullptr);
 
 		while (impl->Next(L, meta, -1) == 2) {
-			LuaElementToEvalResults(L, -2, -1, req);
+			if (IsChildOnPage(req)) {
+				LuaElementToEvalResults(L, -2, -1, req);
+			}
 			lua_pop(L, 1);
 			lua_remove(L, -2);
 		}
@@ -445,10 +528,12 @@ namespace bg3se::lua::dbg
 	void LuaSetToEvalResults(lua_State* L, int index, CppObjectMetadata& meta, DebuggerGetVariablesRequest const& req)
 	{
 		StackCheck _(L);
+		if (!WantsIndexedChildren(req)) return;
+
 		auto impl = SetProxyMetatable::GetImpl(meta);
-		auto len = impl->Length(meta);
+		auto page = ReservePageRange(req, impl->Length(meta));
 
-		for (unsigned i = 1; i <= len; i++) {
+		for (auto i = (unsigned)page.first + 1; i <= (unsigned)page.second; i++) {
 			if (impl->GetElementAt(L, meta, i)) {
 				auto pair = req.Response->add_result();
 				pair->set_type(MsgChildValue::NUMERIC);
@@ -693,6 +778,8 @@ namespace bg3se::lua::dbg
 	void ContextDebugger::OnContextDestroyed()
 	{
 		evalContextRef_ = -1;
+		evalCacheRef_ = -1;
+		evalCacheSize_ = 0;
 	}
 
 	void ContextDebugger::SetupLuaBindings(lua_State* L)
@@ -703,6 +790,9 @@ namespace bg3se::lua::dbg
 		lua_sethook(L, LuaHook, LUA_MASKLINE, 0);
 		lua_newtable(L);
 		evalContextRef_ = luaL_ref(L, LUA_REGISTRYINDEX);
+		lua_newtable(L);
+		evalCacheRef_ = luaL_ref(L, LUA_REGISTRYINDEX);
+		evalCacheSize_ = 0;
 	}
 
 	void ContextDebugger::CleanupLuaBindings(lua_State* L)
@@ -713,6 +803,46 @@ namespace bg3se::lua::dbg
 		lua_sethook(L, nullptr, 0, 0);
 		luaL_unref(L, LUA_REGISTRYINDEX, evalContextRef_);
 		evalContextRef_ = -1;
+		luaL_unref(L, LUA_REGISTRYINDEX, evalCacheRef_);
+		evalCacheRef_ = -1;
+		evalCacheSize_ = 0;
+	}
+
+	bool ContextDebugger::PushCachedExpression(lua_State* L, STDString const& source)
+	{
+		if (evalCacheRef_ == -1) return false;
+
+		lua_rawgeti(L, LUA_REGISTRYINDEX, evalCacheRef_);
+		push(L, source);
+		lua_rawget(L, -2); // stack: cache, func
+		lua_remove(L, -2); // stack: func
+		if (lua_type(L, -1) == LUA_TFUNCTION) {
+			return true;
+		} else {
+			lua_pop(L, 1);
+			return false;
+		}
+	}
+
+	void ContextDebugger::CacheExpression(lua_State* L, STDString const& source)
+	{
+		if (evalCacheRef_ == -1) return;
+
+		if (evalCacheSize_ >= MaxCachedExpressions) {
+			// Drop everything instead of tracking usage; watch lists rarely get this large
+			luaL_unref(L, LUA_REGISTRYINDEX, evalCacheRef_);
+			lua_newtable(L);
+			evalCacheRef_ = luaL_ref(L, LUA_REGISTRYINDEX);
+			evalCacheSize_ = 0;
+		}
+
+		// stack: func
+		lua_rawgeti(L, LUA_REGISTRYINDEX, evalCacheRef_); // stack: func, cache
+		push(L, source); // stack: func, cache, source
+		lua_pushvalue(L, -3); // stack: func, cache, source, func
+		lua_rawset(L, -3); // stack: func, cache
+		lua_pop(L, 1); // stack: func
+		evalCacheSize_++;
 	}
 
 	void ContextDebugger::RequestEnableDebugging(bool enabled)
@@ -915,14 +1045,6 @@ namespace bg3se::lua::dbg
 			}
 		}
 
-		STDString syntaxCheck = "local x = " + req.Expression;
-		if (luaL_loadstring(L, syntaxCheck.c_str())) {
-			req.Response->set_error_message(lua_tostring(L, -1));
-			lua_pop(L, 1);
-			return ResultCode::EvalFailed;
-		}
-
-		lua_pop(L, 1);
 		auto top = lua_gettop(L);
 
 		STDString evalateLocals;
@@ -953,10 +1075,23 @@ namespace bg3se::lua::dbg
 		STDString evaluator = evalateLocals;
 		evaluator += "return " + req.Expression;
 
-		if (luaL_loadstring(L, evaluator.c_str())) {
-			req.Response->set_error_message(lua_tostring(L, -1));
-			lua_pop(L, top - lua_gettop(L));
-			return ResultCode::EvalFailed;
+		if (!PushCachedExpression(L, evaluator)) {
+			STDString syntaxCheck = "local x = " + req.Expression;
+			if (luaL_loadstring(L, syntaxCheck.c_str())) {
+				req.Response->set_error_message(lua_tostring(L, -1));
+				lua_settop(L, top);
+				return ResultCode::EvalFailed;
+			}
+
+			lua_pop(L, 1);
+
+			if (luaL_loadstring(L, evaluator.c_str())) {
+				req.Response->set_error_message(lua_tostring(L, -1));
+				lua_settop(L, top);
+				return ResultCode::EvalFailed;
+			}
+
+			CacheExpression(L, evaluator);
 		}
 
 		if (!locals.empty()) {
@@ -1168,6 +1303,7 @@ namespace bg3se::lua::dbg
 		}
 
 		StackFrameToEvalResults(L, &ar, req.Frame + 1, req.Response);
+		req.Response->set_total_count(req.Response->result_size());
 		return ResultCode::Success;
 	}
 
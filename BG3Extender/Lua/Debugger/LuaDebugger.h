@@ -54,10 +54,19 @@ namespace bg3se::lua::dbg
 		int Frame;
 		int Local;
 		std::vector<KeyType> Key;
+		// Page of children to return; a Count of 0 returns all children
+		int Start{ 0 };
+		int Count{ 0 };
+		DbgGetVariables_Filter Filter{ DbgGetVariables::ALL };
+		// Only count children without fetching their values
+		bool CountOnly{ false };
 		BkGetVariablesResponse* Response;
 		std::function<void(DebuggerGetVariablesRequest const&, ResultCode)> CompletionCallback;
 	};
 
+	// Adds the (paged) children of the table or userdata at the specified stack index to the response
+	void LuaValueToEvalResults(lua_State* L, int index, DebuggerGetVariablesRequest const& req);
+
 
 	class ContextDebugger
 	{
@@ -127,6 +136,12 @@ namespace bg3se::lua::dbg
 		int32_t evaluatingExpression_{ 0 };
 		// Lua registry index of global evaluation results
 		int evalContextRef_{ -1 };
+		// Lua registry index of compiled evaluation expressions, keyed by expression source.
+		// The source includes the local variable prelude, so the key covers both the expression
+		// text and the shape of the stack frame it is evaluated in.
+		int evalCacheRef_{ -1 };
+		unsigned evalCacheSize_{ 0 };
+		static constexpr unsigned MaxCachedExpressions = 256;
 
 		// Breakpoint set currently in use by the debugger
 		std::unique_ptr<BreakpointSet> breakpoints_;
@@ -142,6 +157,8 @@ namespace bg3se::lua::dbg
 		void TriggerBreakpoint(lua_State* L, BkBreakpointTriggered_Reason reason, char const* msg);
 
 		ResultCode EvaluateInContext(DebuggerEvaluateRequest const& req);
+		bool PushCachedExpression(lua_State* L, STDString const& source);
+		void CacheExpression(lua_State* L, STDString const& source);
 		bool PushVariableContext(lua_State* L, DebuggerGetVariablesRequest const& req);
 
 		ResultCode GetVariablesInContext(DebuggerGetVariablesRequest const& req);
@@ -1,4 +1,5 @@
 #include <Extender/ScriptExtender.h>
+#include <chrono>
 
 /// <lua_module>Debug</lua_module>
 BEGIN_NS(lua::debug)
@@ -98,22 +99,63 @@ char const * OsiToLuaTypeName(ValueType type)
 	}
 }
 
-STDString DoGenerateIdeHelpers(bool builtinOnly)
+bool IsIdeHelperFunction(Function const* func, bool builtinOnly)
 {
-	STDString helpers;
-	helpers.reserve(0x20000);
+	return !builtinOnly
+		|| func->Type == FunctionType::Event
+		|| func->Type == FunctionType::Call
+		|| func->Type == FunctionType::Query
+		|| func->Type == FunctionType::SysCall
+		|| func->Type == FunctionType::SysQuery;
+}
+
+// Hash of the signatures of all functions that helpers are generated for.
+// The generated file only depends on these, so it doesn't need to be regenerated while the hash is unchanged.
+// Bump when the output of DoGenerateIdeHelpers() changes, so existing helper files are regenerated
+static constexpr uint32_t IdeHelperGeneratorVersion = 1;
+
+uint64_t HashIdeHelperFunctions(bool builtinOnly)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto hashBytes = [&hash](void const* data, std::size_t size) {
+		auto bytes = reinterpret_cast<uint8_t const*>(data);
+		for (std::size_t i = 0; i < size; i++) {
+			hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+		}
+	};
+
+	hashBytes(&IdeHelperGeneratorVersion, sizeof(IdeHelperGeneratorVersion));
+	hashBytes(&builtinOnly, sizeof(builtinOnly));
 
+	auto functions = gExtender->GetServer().Osiris().GetGlobals().Functions;
+	(*functions)->Iterate([&hashBytes, builtinOnly](OsiString const & key, Function const * func) {
+		if (!IsIdeHelperFunction(func, builtinOnly)) {
+			return;
+		}
+
+		hashBytes(func->Signature->Name, strlen(func->Signature->Name) + 1);
+		hashBytes(&func->Type, sizeof(func->Type));
+
+		auto const & outParams = func->Signature->OutParamList;
+		auto types = func->Signature->Params->Params.Head;
+		for (auto i = 0; i < func->Signature->Params->Params.Size; i++) {
+			types = types->Next;
+			uint32_t param = ((uint32_t)types->Item.Type << 1) | (outParams.isOutParam(i) ? 1 : 0);
+			hashBytes(&param, sizeof(param));
+		}
+	});
+
+	return hash;
+}
+
+void DoGenerateIdeHelpers(std::ostream& helpers, bool builtinOnly)
+{
 	STDString functionComment, functionDefn;
 
 	auto functions = gExtender->GetServer().Osiris().GetGlobals().Functions;
 
 	(*functions)->Iterate([&helpers, &functionComment, &functionDefn, builtinOnly](OsiString const & key, Function const * func) {
-		if (builtinOnly
-			&& func->Type != FunctionType::Event
-			&& func->Type != FunctionType::Call
-			&& func->Type != FunctionType::Query
-			&& func->Type != FunctionType::SysCall
-			&& func->Type != FunctionType::SysQuery) {
+		if (!IsIdeHelperFunction(func, builtinOnly)) {
 			return;
 		}
 
@@ -170,22 +212,13 @@ STDString DoGenerateIdeHelpers(bool builtinOnly)
 
 		functionDefn += ") end\r\n\r\n";
 
-		helpers += functionComment;
-		helpers += "Osi.";
-		helpers += functionDefn;
+		helpers << functionComment << "Osi." << functionDefn;
 
 		// Export global name if function is a builtin
-		if (func->Type == FunctionType::Event
-			|| func->Type == FunctionType::Call
-			|| func->Type == FunctionType::Query
-			|| func->Type == FunctionType::SysCall
-			|| func->Type == FunctionType::SysQuery) {
-			helpers += functionComment;
-			helpers += functionDefn;
+		if (IsIdeHelperFunction(func, true)) {
+			helpers << functionComment << functionDefn;
 		}
 	});
-
-	return helpers;
 }
 
 void GenerateIdeHelpers(lua_State* L, std::optional<bool> builtinOnly)
@@ -198,20 +231,53 @@ void GenerateIdeHelpers(lua_State* L, std::optional<bool> builtinOnly)
 			luaL_error(L, "GenerateIdeHelpers() can only be called when Osiris is available");
 		}
 
-		auto helpers = DoGenerateIdeHelpers(builtinOnly && *builtinOnly);
-
 		auto path = GetStaticSymbols().ToPath("", PathRootType::Data);
 		path += "Mods/";
 		path += GetStaticSymbols().GetModManagerServer()->BaseModule.Info.Directory;
 		path += "/Story/RawFiles/Lua/OsiIdeHelpers.lua";
 
-		std::ofstream f(path.c_str(), std::ios::out | std::ios::binary);
-		if (!f.good()) {
-			OsiError("Could not open file to save IDE helpers: '" << path << "'");
-			return;
+		// The first line of the file records the hash of the functions it was generated from;
+		// skip regeneration if the story functions haven't changed since
+		char header[64];
+		sprintf_s(header, "-- Osiris helpers for story %016llx", HashIdeHelperFunctions(builtinOnly && *builtinOnly));
+
+		{
+			std::ifstream existing(path.c_str(), std::ios::in | std::ios::binary);
+			std::string existingHeader;
+			if (existing.good() && std::getline(existing, existingHeader)) {
+				if (!existingHeader.empty() && existingHeader.back() == '\r') {
+					existingHeader.pop_back();
+				}
+
+				if (existingHeader == header) {
+					DEBUG("IDE helpers are up to date, skipping generation");
+					return;
+				}
+			}
+		}
+
+		// Write to a temp file first, so an interrupted generation won't leave a
+		// truncated file behind with a valid header
+		auto tempPath = path + ".tmp";
+		{
+			std::ofstream f(tempPath.c_str(), std::ios::out | std::ios::binary);
+			if (!f.good()) {
+				OsiError("Could not open file to save IDE helpers: '" << tempPath << "'");
+				return;
+			}
+
+			f << header << "\r\n\r\n";
+			DoGenerateIdeHelpers(f, builtinOnly && *builtinOnly);
+			f.flush();
+			if (!f.good()) {
+				OsiError("Could not write IDE helpers to '" << tempPath << "'");
+				return;
+			}
 		}
 
-		f.write(helpers.c_str(), helpers.size());
+		if (!MoveFileExW(FromUTF8(tempPath).c_str(), FromUTF8(path).c_str(), MOVEFILE_REPLACE_EXISTING)) {
+			OsiError("Could not replace IDE helpers file '" << path << "'");
+		}
 #if defined(OSI_EOCAPP)
 	} else {
 		OsiError("GenerateIdeHelpers() only supported in developer mode");
@@ -234,6 +300,42 @@ void LuaDebugBreak(lua_State* L)
 #endif
 }
 
+// Runs a debugger variables request against the value in the first argument and returns
+// the total number of children and the keys of the children on the requested page.
+// Only used for testing debugger paging without an attached debugger frontend;
+// registered as Ext._Internal._GetDebuggerVariables in developer mode.
+UserReturn GetDebuggerVariables(lua_State* L)
+{
+	luaL_checkany(L, 1);
+#if !defined(OSI_NO_DEBUGGER)
+	dbg::DebuggerGetVariablesRequest req;
+	dbg::BkGetVariablesResponse response;
+	req.Start = (int)luaL_optinteger(L, 2, 0);
+	req.Count = (int)luaL_optinteger(L, 3, 0);
+	req.Filter = (dbg::DbgGetVariables_Filter)luaL_optinteger(L, 4, dbg::DbgGetVariables::ALL);
+	req.CountOnly = lua_toboolean(L, 5) != 0;
+	req.Response = &response;
+	dbg::LuaValueToEvalResults(L, 1, req);
+
+	lua_newtable(L);
+	setfield(L, "TotalCount", response.total_count());
+	lua_newtable(L);
+	for (int i = 0; i < response.result_size(); i++) {
+		auto const& child = response.result(i);
+		if (child.type() == dbg::MsgChildValue::NUMERIC) {
+			push(L, child.index());
+		} else {
+			push(L, child.name().c_str());
+		}
+		lua_rawseti(L, -2, i + 1);
+	}
+	lua_setfield(L, -2, "Keys");
+#else
+	push(L, nullptr);
+#endif
+	return 1;
+}
+
 // Development-only function for testing crash reporting
 void Crash(int type)
 {
@@ -264,6 +366,456 @@ void SetEntityRuntimeCheckLevel(int level)
 	}
 }
 
+// Keeps the optimizer from discarding benchmark loops whose results are otherwise unused
+volatile uint64_t BenchmarkSink{ 0 };
+
+template <class Fun>
+double BenchmarkNsPerOp(uint32_t ops, Fun fun)
+{
+	auto start = std::chrono::steady_clock::now();
+	fun();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+template <class TKey>
+void BenchmarkKeyedContainers(lua_State* L, char const* keyName, std::vector<TKey> const& keys)
+{
+	auto n = (uint32_t)keys.size();
+	STDString prefix;
+
+	{
+		prefix = STDString("Map<") + keyName + ">.";
+		Map<TKey, uint32_t> map(GetNearestLowerPrime(n));
+
+		setfield(L, (prefix + "Insert").c_str(), BenchmarkNsPerOp(n, [&]() {
+			for (uint32_t i = 0; i < n; i++) {
+				map.insert(keys[i], i);
+			}
+		}));
+
+		setfield(L, (prefix + "Find").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto const& key : keys) {
+				auto value = map.try_get_ptr(key);
+				if (value) sum += *value;
+			}
+			BenchmarkSink += sum;
+		}));
+
+		setfield(L, (prefix + "Iterate").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto it = map.begin(); it != map.end(); it++) {
+				sum += it.Value();
+			}
+			BenchmarkSink += sum;
+		}));
+
+		// MapBase::erase() doesn't release nodes, so removal is measured through clear()
+		setfield(L, (prefix + "Clear").c_str(), BenchmarkNsPerOp(n, [&]() {
+			map.clear();
+		}));
+	}
+
+	{
+		prefix = STDString("MultiHashMap<") + keyName + ">.";
+		MultiHashMap<TKey, uint32_t> map;
+
+		setfield(L, (prefix + "Insert").c_str(), BenchmarkNsPerOp(n, [&]() {
+			for (uint32_t i = 0; i < n; i++) {
+				map.Set(keys[i], i);
+			}
+		}));
+
+		setfield(L, (prefix + "Find").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto const& key : keys) {
+				auto value = map.Find(key);
+				if (value) sum += **value;
+			}
+			BenchmarkSink += sum;
+		}));
+
+		setfield(L, (prefix + "Iterate").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto it = map.begin(); it != map.end(); it++) {
+				sum += it.Value();
+			}
+			BenchmarkSink += sum;
+		}));
+
+		setfield(L, (prefix + "Erase").c_str(), BenchmarkNsPerOp(n, [&]() {
+			for (auto const& key : keys) {
+				map.remove(key);
+			}
+		}));
+	}
+
+	{
+		prefix = STDString("Array<") + keyName + ">.";
+		Array<TKey> arr;
+
+		setfield(L, (prefix + "Insert").c_str(), BenchmarkNsPerOp(n, [&]() {
+			for (auto const& key : keys) {
+				arr.push_back(key);
+			}
+		}));
+
+		setfield(L, (prefix + "Iterate").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto const& key : arr) {
+				sum += Hash(key);
+			}
+			BenchmarkSink += sum;
+		}));
+
+		setfield(L, (prefix + "Erase").c_str(), BenchmarkNsPerOp(n, [&]() {
+			while (arr.size() > 0) {
+				arr.remove_last();
+			}
+		}));
+	}
+
+	{
+		prefix = STDString("Queue<") + keyName + ">.";
+		Queue<TKey> queue;
+
+		setfield(L, (prefix + "Insert").c_str(), BenchmarkNsPerOp(n, [&]() {
+			for (auto const& key : keys) {
+				queue.push_back(key);
+			}
+		}));
+
+		setfield(L, (prefix + "Erase").c_str(), BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			while (!queue.empty()) {
+				sum += Hash(queue.pop());
+			}
+			BenchmarkSink += sum;
+		}));
+	}
+
+	setfield(L, (STDString("Hash<") + keyName + ">").c_str(), BenchmarkNsPerOp(n, [&]() {
+		uint64_t sum{ 0 };
+		for (auto const& key : keys) {
+			sum += MultiHashMapHash(key);
+		}
+		BenchmarkSink += sum;
+	}));
+}
+
+// Measures insert, lookup, iteration and erase performance of the core container types
+// with Guid, FixedString and EntityHandle keys. Results are in nanoseconds per operation.
+// This runs in-process, as the containers depend on the game allocator and string table.
+// Only available in developer mode, since each key count interns a new set of FixedStrings permanently.
+UserReturn BenchmarkContainers(lua_State* L, std::optional<uint32_t> numKeys)
+{
+	if (!gExtender->GetConfig().DeveloperMode) {
+		OsiError("BenchmarkContainers() only supported in developer mode");
+		push(L, nullptr);
+		return 1;
+	}
+
+	auto n = std::clamp(numKeys.value_or(10000u), 1u, 100000u);
+	std::mt19937_64 rng(0x5e5e5e5e);
+
+	std::vector<Guid> guids;
+	std::vector<EntityHandle> handles;
+	std::vector<STDString> strings;
+	guids.reserve(n);
+	handles.reserve(n);
+	strings.reserve(n);
+
+	for (uint32_t i = 0; i < n; i++) {
+		Guid guid;
+		guid.Val[0] = rng();
+		guid.Val[1] = rng();
+		guids.push_back(guid);
+		strings.push_back(guid.ToString());
+
+		// Entities are clustered in a few archetypes with mostly sequential indices and low salt values
+		handles.push_back(EntityHandle(rng() % 8, i + (rng() % 4), rng() % 4));
+	}
+
+	// FixedStrings are interned permanently, so reuse the same key set between runs
+	// instead of generating new random names each time; the key count cap bounds the set
+	std::vector<FixedString> fixedStrings;
+	fixedStrings.reserve(n);
+	char name[64];
+	for (uint32_t i = 0; i < n; i++) {
+		sprintf_s(name, "SE_Benchmark_Key_%08x", i);
+		fixedStrings.push_back(FixedString(name));
+	}
+
+	lua_newtable(L);
+	BenchmarkKeyedContainers(L, "Guid", guids);
+	BenchmarkKeyedContainers(L, "FixedString", fixedStrings);
+	BenchmarkKeyedContainers(L, "EntityHandle", handles);
+
+	setfield(L, "Hash<STDString>", BenchmarkNsPerOp(n, [&]() {
+		uint64_t sum{ 0 };
+		for (auto const& str : strings) {
+			sum += Hash(str);
+		}
+		BenchmarkSink += sum;
+	}));
+
+	setfield(L, "FixedString.Create", BenchmarkNsPerOp(n, [&]() {
+		uint64_t sum{ 0 };
+		for (auto const& str : fixedStrings) {
+			sum += FixedString(str.GetStringView()).GetHash();
+		}
+		BenchmarkSink += sum;
+	}));
+
+	{
+		BitSet<> bits;
+		setfield(L, "BitSet.Set", BenchmarkNsPerOp(n, [&]() {
+			for (auto handle : handles) {
+				bits.Set(handle.GetIndex());
+			}
+		}));
+
+		setfield(L, "BitSet.Get", BenchmarkNsPerOp(n, [&]() {
+			uint64_t sum{ 0 };
+			for (auto handle : handles) {
+				sum += bits.Get(handle.GetIndex()) ? 1 : 0;
+			}
+			BenchmarkSink += sum;
+		}));
+
+		setfield(L, "BitSet.Clear", BenchmarkNsPerOp(n, [&]() {
+			for (auto handle : handles) {
+				bits.Clear(handle.GetIndex());
+			}
+		}));
+	}
+
+	return 1;
+}
+
+// Returns allocation statistics of the allocator of the current Lua state
+UserReturn GetLuaMemoryStats(lua_State* L)
+{
+	auto& allocator = State::FromLua(L)->GetAllocator();
+	auto const& stats = allocator.GetStatistics();
+
+	lua_newtable(L);
+	setfield(L, "LiveBytes", stats.LiveBytes);
+	setfield(L, "PeakBytes", stats.PeakBytes);
+	setfield(L, "SlabBytes", stats.SlabBytes);
+	setfield(L, "AllocatedBytes", stats.AllocatedBytes);
+	setfield(L, "NumAllocations", stats.NumAllocations);
+	setfield(L, "NumFrees", stats.NumFrees);
+	setfield(L, "NumReallocations", stats.NumReallocations);
+	setfield(L, "NumInPlaceReallocations", stats.NumInPlaceReallocations);
+	setfield(L, "AllocationsPerSec", allocator.SampleAllocationRate());
+	return 1;
+}
+
+// Starts recording allocator calls of the current Lua state; the trace is consumed by BenchmarkLuaAllocator()
+// Only available in developer mode, as the trace can grow to 10M entries.
+void StartLuaAllocationTrace(lua_State* L, std::optional<uint32_t> maxEntries)
+{
+	if (!gExtender->GetConfig().DeveloperMode) {
+		OsiError("StartLuaAllocationTrace() only supported in developer mode");
+		return;
+	}
+
+	State::FromLua(L)->GetAllocator().StartTrace(std::clamp(maxEntries.value_or(1000000u), 1u, 10000000u));
+}
+
+template <class Fun>
+double ReplayAllocationTrace(std::vector<LuaAllocator::TraceEntry> const& trace, uint32_t numBlocks, Fun realloc)
+{
+	std::vector<void*> blocks(numBlocks, nullptr);
+	auto nsPerOp = BenchmarkNsPerOp((uint32_t)trace.size(), [&]() {
+		for (auto const& entry : trace) {
+			auto& block = blocks[entry.Block];
+			block = realloc(block, entry.OldSize, entry.NewSize);
+		}
+	});
+
+	// Release blocks that were still live when the trace was stopped
+	for (uint32_t i = 0; i < numBlocks; i++) {
+		if (blocks[i] != nullptr) {
+			realloc(blocks[i], 0, 0);
+		}
+	}
+
+	return nsPerOp;
+}
+
+// Stops the allocation trace started by StartLuaAllocationTrace() and replays it against
+// the size class allocator and the plain game allocator. Results are in nanoseconds per call.
+UserReturn BenchmarkLuaAllocator(lua_State* L)
+{
+	if (!gExtender->GetConfig().DeveloperMode) {
+		OsiError("BenchmarkLuaAllocator() only supported in developer mode");
+		push(L, nullptr);
+		return 1;
+	}
+
+	auto trace = State::FromLua(L)->GetAllocator().StopTrace();
+	if (trace.empty()) {
+		OsiError("No allocation trace was recorded; call Ext.Debug.StartLuaAllocationTrace() first");
+		push(L, nullptr);
+		return 1;
+	}
+
+	uint32_t numBlocks{ 0 };
+	uint32_t liveBlocks{ 0 };
+	for (auto const& entry : trace) {
+		numBlocks = std::max(numBlocks, entry.Block + 1);
+	}
+
+	std::vector<std::size_t> sizes(numBlocks, 0);
+	for (auto const& entry : trace) {
+		sizes[entry.Block] = entry.NewSize;
+	}
+
+	for (auto size : sizes) {
+		if (size > 0) liveBlocks++;
+	}
+
+	lua_newtable(L);
+	setfield(L, "NumCalls", (uint32_t)trace.size());
+	setfield(L, "NumBlocks", numBlocks);
+	setfield(L, "LiveBlocks", liveBlocks);
+
+	{
+		LuaAllocator allocator;
+		setfield(L, "SizeClassAllocator", ReplayAllocationTrace(trace, numBlocks, [&](void* ptr, std::size_t osize, std::size_t nsize) {
+			return allocator.Realloc(ptr, osize, nsize);
+		}));
+	}
+
+	setfield(L, "GameAllocator", ReplayAllocationTrace(trace, numBlocks, [&](void* ptr, std::size_t osize, std::size_t nsize) {
+		return LuaAllocator::GameAllocatorRealloc(ptr, osize, nsize);
+	}));
+
+	return 1;
+}
+
+// Returns the owner ID the profiler attributes calls of the handler to.
+// Callable tables are attributed to the owner of their __call metamethod; handlers
+// whose owner can't be determined are attributed to "unknown".
+uint32_t GetHandlerOwner(lua_State* L)
+{
+	luaL_checkany(L, 1);
+	auto& profiler = State::FromLua(L)->GetModProfiler();
+	if (lua_type(L, 1) == LUA_TFUNCTION) {
+		return profiler.GetOwner(L, 1);
+	}
+
+	if (luaL_getmetafield(L, 1, "__call") != LUA_TNIL) {
+		uint32_t owner = ModProfiler::NoOwner;
+		if (lua_type(L, -1) == LUA_TFUNCTION) {
+			owner = profiler.GetOwner(L, -1);
+		}
+		lua_pop(L, 1);
+
+		if (owner != ModProfiler::NoOwner) {
+			return owner;
+		}
+	}
+
+	return profiler.GetOwner("=unknown");
+}
+
+// Calls fn(...) in protected mode, charging the time spent to the specified owner.
+// Returns whether the call succeeded, the error message (if any), and whether the handler should be
+// disabled because its mod exceeded its quota.
+UserReturn ProfiledCall(lua_State* L)
+{
+	auto owner = (uint32_t)luaL_checkinteger(L, 1);
+	luaL_checkany(L, 2);
+	auto& profiler = State::FromLua(L)->GetModProfiler();
+
+	ModProfiler::Scope profile(profiler, owner);
+	auto status = CallWithTraceback(L, lua_gettop(L) - 2, 0);
+	auto disable = profile.Exit();
+
+	push(L, status == LUA_OK);
+	if (status == LUA_OK) {
+		push(L, nullptr);
+	} else {
+		lua_pushvalue(L, -2);
+	}
+	push(L, disable);
+	return 3;
+}
+
+/// <summary>
+/// Returns the Lua CPU time and allocations attributed to each mod since the state was created
+/// or the last ResetModProfile() call. Time is exclusive, i.e. the time spent in nested handlers is
+/// only attributed to the innermost handler.
+/// </summary>
+UserReturn GetModProfile(lua_State* L)
+{
+	auto& profiler = State::FromLua(L)->GetModProfiler();
+
+	lua_newtable(L);
+	for (auto const& mod : profiler.GetStatistics()) {
+		lua_newtable(L);
+		setfield(L, "Calls", mod.Calls);
+		setfield(L, "TimeMs", profiler.TicksToMs(mod.Ticks));
+		setfield(L, "AllocatedBytes", mod.AllocatedBytes);
+		setfield(L, "Allocations", mod.Allocations);
+		setfield(L, "QuotaExceeded", mod.QuotaExceeded);
+		lua_setfield(L, -2, mod.Name.c_str());
+	}
+
+	return 1;
+}
+
+void ResetModProfile(lua_State* L)
+{
+	State::FromLua(L)->GetModProfiler().ResetStatistics();
+}
+
+/// <summary>
+/// Sets a soft quota of `budgetMs` milliseconds of Lua time that a mod may use within a sliding window
+/// of `windowMs` milliseconds (default 1000). Mods are named as in GetModProfile().
+/// If the mod exceeds its budget, a warning is logged and (if `disable` is set) the event handler
+/// that was running is unsubscribed. Passing nil as the mod name sets the default quota of all mods;
+/// passing nil as the budget removes the quota.
+/// </summary>
+void SetModQuota(lua_State* L, std::optional<STDString> mod, std::optional<double> budgetMs, std::optional<double> windowMs, std::optional<bool> disable)
+{
+	std::optional<ModProfiler::Quota> quota;
+	if (budgetMs) {
+		quota = ModProfiler::Quota{ *budgetMs, windowMs.value_or(1000.0), disable.value_or(false) };
+	}
+
+	State::FromLua(L)->GetModProfiler().SetQuota(mod.value_or(""), quota);
+}
+
+// The profiler hooks of the event dispatcher are kept out of Ext.Debug, as they'd let mods
+// charge time to the quota of another mod
+void RegisterInternalDebugLib(lua_State* L)
+{
+	static const luaL_Reg internalLib[] = {
+		{"_GetHandlerOwner", LuaWrapFunction(&GetHandlerOwner)},
+		{"_ProfiledCall", LuaWrapFunction(&ProfiledCall)},
+		{0,0}
+	};
+
+	RegisterLib(L, "_Internal", internalLib);
+
+	if (gExtender->GetConfig().DeveloperMode) {
+		static const luaL_Reg testLib[] = {
+			{"_GetDebuggerVariables", LuaWrapFunction(&GetDebuggerVariables)},
+			{0,0}
+		};
+
+		lua_getglobal(L, "Ext"); // stack: Ext
+		lua_getfield(L, -1, "_Internal"); // stack: Ext, _Internal
+		luaL_setfuncs(L, testLib, 0);
+		lua_pop(L, 2);
+	}
+}
+
 void RegisterDebugLib()
 {
 	DECLARE_MODULE(Debug, Both)
@@ -274,6 +826,13 @@ void RegisterDebugLib()
 	MODULE_NAMED_FUNCTION("DebugBreak", LuaDebugBreak)
 	MODULE_FUNCTION(IsDeveloperMode)
 	MODULE_FUNCTION(SetEntityRuntimeCheckLevel)
+	MODULE_FUNCTION(BenchmarkContainers)
+	MODULE_FUNCTION(GetLuaMemoryStats)
+	MODULE_FUNCTION(StartLuaAllocationTrace)
+	MODULE_FUNCTION(BenchmarkLuaAllocator)
+	MODULE_FUNCTION(GetModProfile)
+	MODULE_FUNCTION(ResetModProfile)
+	MODULE_FUNCTION(SetModQuota)
 	MODULE_FUNCTION(Crash)
 	END_MODULE()
 }
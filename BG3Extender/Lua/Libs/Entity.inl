@@ -67,7 +67,9 @@ Array<EntityHandle> GetAllEntities(lua_State* L)
 	return entities;
 }
 
-void Subscribe(lua_State* L, ExtComponentType type, FunctionRef func, std::optional<EntityHandle> entity, std::optional<uint64_t> flags)
+// Subscribes to replication events of a component type; returns the subscription index for Unsubscribe().
+// Subscribing without flags (i.e. all bits set) also receives changes to flags past the first 64.
+uint32_t Subscribe(lua_State* L, ExtComponentType type, FunctionRef func, std::optional<EntityHandle> entity, std::optional<uint64_t> flags)
 {
 	auto hooks = State::FromLua(L)->GetReplicationEventHooks();
 	if (!hooks) {
@@ -79,7 +81,7 @@ void Subscribe(lua_State* L, ExtComponentType type, FunctionRef func, std::optio
 		luaL_error(L, "No events are available for components of type %s", EnumInfo<ExtComponentType>::Store->Find((EnumUnderlyingType)type).GetString());
 	}
 
-	hooks->Subscribe(*replicationType, entity ? *entity : EntityHandle{}, flags ? *flags : 0xffffffffffffffffull, RegistryEntry(L, func.Index));
+	return hooks->Subscribe(*replicationType, entity ? *entity : EntityHandle{}, flags ? *flags : 0xffffffffffffffffull, RegistryEntry(L, func.Index));
 }
 
 bool Unsubscribe(lua_State* L, unsigned index)
@@ -0,0 +1,437 @@
+#include <Lua/Shared/LuaEntityHandleSet.h>
+
+BEGIN_NS(lua)
+
+std::size_t EntityHandleTable::Hash(EntityHandle handle) const
+{
+	// Index bits are in the low word and salt/type in the high word; mix them so
+	// sequential indices don't end up in neighbouring buckets
+	auto h = handle.Handle;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return (std::size_t)h;
+}
+
+std::size_t EntityHandleTable::FindBucket(EntityHandle handle) const
+{
+	auto bucket = Hash(handle) & BucketMask();
+	while (buckets_[bucket] != EmptyBucket && handles_[buckets_[bucket]] != handle) {
+		bucket = (bucket + 1) & BucketMask();
+	}
+
+	return bucket;
+}
+
+std::optional<uint32_t> EntityHandleTable::Find(EntityHandle handle) const
+{
+	if (handles_.empty()) {
+		return {};
+	}
+
+	auto index = buckets_[FindBucket(handle)];
+	if (index != EmptyBucket) {
+		return index;
+	} else {
+		return {};
+	}
+}
+
+std::pair<uint32_t, bool> EntityHandleTable::Insert(EntityHandle handle)
+{
+	// Keep the load factor under 0.5 so probe sequences stay short
+	if ((handles_.size() + 1) * 2 > buckets_.size()) {
+		Rehash(std::max<std::size_t>(MinBuckets, buckets_.size() * 2));
+	}
+
+	auto bucket = FindBucket(handle);
+	if (buckets_[bucket] != EmptyBucket) {
+		return std::make_pair(buckets_[bucket], false);
+	}
+
+	auto index = (uint32_t)handles_.size();
+	buckets_[bucket] = index;
+	handles_.push_back(handle);
+	return std::make_pair(index, true);
+}
+
+std::optional<uint32_t> EntityHandleTable::Remove(EntityHandle handle)
+{
+	if (handles_.empty()) {
+		return {};
+	}
+
+	auto bucket = FindBucket(handle);
+	auto index = buckets_[bucket];
+	if (index == EmptyBucket) {
+		return {};
+	}
+
+	EraseBucket(bucket);
+
+	auto lastIndex = (uint32_t)handles_.size() - 1;
+	if (index != lastIndex) {
+		auto lastHandle = handles_[lastIndex];
+		buckets_[FindBucket(lastHandle)] = index;
+		handles_[index] = lastHandle;
+	}
+
+	handles_.pop_back();
+	return index;
+}
+
+void EntityHandleTable::EraseBucket(std::size_t bucket)
+{
+	// Backward shift deletion; shifts later entries of the probe sequence into the hole
+	// instead of leaving tombstones behind
+	auto hole = bucket;
+	auto next = (hole + 1) & BucketMask();
+	while (buckets_[next] != EmptyBucket) {
+		auto home = Hash(handles_[buckets_[next]]) & BucketMask();
+		if (((next - home) & BucketMask()) >= ((next - hole) & BucketMask())) {
+			buckets_[hole] = buckets_[next];
+			hole = next;
+		}
+
+		next = (next + 1) & BucketMask();
+	}
+
+	buckets_[hole] = EmptyBucket;
+}
+
+void EntityHandleTable::Rehash(std::size_t numBuckets)
+{
+	buckets_.assign(numBuckets, EmptyBucket);
+	for (uint32_t i = 0; i < handles_.size(); i++) {
+		auto bucket = Hash(handles_[i]) & BucketMask();
+		while (buckets_[bucket] != EmptyBucket) {
+			bucket = (bucket + 1) & BucketMask();
+		}
+
+		buckets_[bucket] = i;
+	}
+}
+
+void EntityHandleTable::Clear()
+{
+	handles_.clear();
+	buckets_.clear();
+}
+
+
+// Calls the handler for each handle in a handle set, handle map or an array of entities
+template <class Fun>
+void ForEachHandleIn(lua_State* L, int index, Fun fun)
+{
+	if (auto set = EntityHandleSet::AsUserData(L, index)) {
+		auto& handles = set->Handles();
+		for (uint32_t i = 0; i < handles.Size(); i++) {
+			fun(handles[i]);
+		}
+	} else if (auto map = EntityHandleMap::AsUserData(L, index)) {
+		auto& handles = map->Handles();
+		for (uint32_t i = 0; i < handles.Size(); i++) {
+			fun(handles[i]);
+		}
+	} else {
+		luaL_checktype(L, index, LUA_TTABLE);
+		auto len = (int)lua_rawlen(L, index);
+		for (int i = 1; i <= len; i++) {
+			lua_rawgeti(L, index, i);
+			fun(get<EntityHandle>(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+}
+
+
+char const* const EntityHandleSet::MetatableName = "EntityHandleSet";
+
+void EntityHandleSet::PopulateMetatable(lua_State* L)
+{
+	lua_newtable(L);
+
+	lua_pushcfunction(L, &Contains);
+	lua_setfield(L, -2, "Contains");
+
+	lua_pushcfunction(L, &Add);
+	lua_setfield(L, -2, "Add");
+
+	lua_pushcfunction(L, &Remove);
+	lua_setfield(L, -2, "Remove");
+
+	lua_pushcfunction(L, &Clear);
+	lua_setfield(L, -2, "Clear");
+
+	lua_pushcfunction(L, &Union);
+	lua_setfield(L, -2, "Union");
+
+	lua_pushcfunction(L, &Intersect);
+	lua_setfield(L, -2, "Intersect");
+
+	lua_pushcfunction(L, &ToTable);
+	lua_setfield(L, -2, "ToTable");
+
+	lua_setfield(L, -2, "__index");
+}
+
+EntityHandleSet* EntityHandleSet::Make(lua_State* L)
+{
+	return New(L);
+}
+
+int EntityHandleSet::Length(lua_State* L)
+{
+	push(L, handles_.Size());
+	return 1;
+}
+
+int EntityHandleSet::Next(lua_State* L)
+{
+	uint32_t index{ 0 };
+	if (!lua_isnil(L, 2)) {
+		auto prev = handles_.Find(get<EntityHandle>(L, 2));
+		if (!prev) {
+			return luaL_error(L, "Invalid key passed to next()");
+		}
+
+		index = *prev + 1;
+	}
+
+	if (index < handles_.Size()) {
+		push(L, handles_[index]);
+		push(L, true);
+		return 2;
+	} else {
+		push(L, nullptr);
+		return 1;
+	}
+}
+
+int EntityHandleSet::Contains(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	push(L, (bool)self->handles_.Find(get<EntityHandle>(L, 2)));
+	return 1;
+}
+
+int EntityHandleSet::Add(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	push(L, self->handles_.Insert(get<EntityHandle>(L, 2)).second);
+	return 1;
+}
+
+int EntityHandleSet::Remove(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	push(L, (bool)self->handles_.Remove(get<EntityHandle>(L, 2)));
+	return 1;
+}
+
+int EntityHandleSet::Clear(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	self->handles_.Clear();
+	return 0;
+}
+
+int EntityHandleSet::Union(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	ForEachHandleIn(L, 2, [self](EntityHandle handle) {
+		self->handles_.Insert(handle);
+	});
+	return 0;
+}
+
+int EntityHandleSet::Intersect(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	EntityHandleTable other;
+	ForEachHandleIn(L, 2, [&other](EntityHandle handle) {
+		other.Insert(handle);
+	});
+
+	for (uint32_t i = self->handles_.Size(); i > 0; i--) {
+		auto handle = self->handles_[i - 1];
+		if (!other.Find(handle)) {
+			self->handles_.Remove(handle);
+		}
+	}
+
+	return 0;
+}
+
+int EntityHandleSet::ToTable(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	lua_createtable(L, (int)self->handles_.Size(), 0);
+	for (uint32_t i = 0; i < self->handles_.Size(); i++) {
+		push(L, self->handles_[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+
+char const* const EntityHandleMap::MetatableName = "EntityHandleMap";
+
+void EntityHandleMap::PopulateMetatable(lua_State* L)
+{
+	lua_newtable(L);
+
+	lua_pushcfunction(L, &Contains);
+	lua_setfield(L, -2, "Contains");
+
+	lua_pushcfunction(L, &Get);
+	lua_setfield(L, -2, "Get");
+
+	lua_pushcfunction(L, &Set);
+	lua_setfield(L, -2, "Set");
+
+	lua_pushcfunction(L, &Remove);
+	lua_setfield(L, -2, "Remove");
+
+	lua_pushcfunction(L, &Clear);
+	lua_setfield(L, -2, "Clear");
+
+	lua_pushcfunction(L, &Keys);
+	lua_setfield(L, -2, "Keys");
+
+	lua_setfield(L, -2, "__index");
+}
+
+EntityHandleMap* EntityHandleMap::Make(lua_State* L)
+{
+	auto self = New(L);
+	lua_newtable(L);
+	lua_setuservalue(L, -2);
+	return self;
+}
+
+int EntityHandleMap::Length(lua_State* L)
+{
+	push(L, handles_.Size());
+	return 1;
+}
+
+int EntityHandleMap::Next(lua_State* L)
+{
+	uint32_t index{ 0 };
+	if (!lua_isnil(L, 2)) {
+		auto prev = handles_.Find(get<EntityHandle>(L, 2));
+		if (!prev) {
+			return luaL_error(L, "Invalid key passed to next()");
+		}
+
+		index = *prev + 1;
+	}
+
+	if (index < handles_.Size()) {
+		push(L, handles_[index]);
+		lua_getuservalue(L, 1);
+		lua_rawgeti(L, -1, index + 1);
+		lua_remove(L, -2);
+		return 2;
+	} else {
+		push(L, nullptr);
+		return 1;
+	}
+}
+
+void EntityHandleMap::RemoveValue(lua_State* L, int valuesIdx, uint32_t index)
+{
+	// Mirror the swap-remove done by the handle table
+	auto lastIndex = handles_.Size();
+	if (index != lastIndex) {
+		lua_rawgeti(L, valuesIdx, lastIndex + 1);
+		lua_rawseti(L, valuesIdx, index + 1);
+	}
+
+	lua_pushnil(L);
+	lua_rawseti(L, valuesIdx, lastIndex + 1);
+}
+
+int EntityHandleMap::Contains(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	push(L, (bool)self->handles_.Find(get<EntityHandle>(L, 2)));
+	return 1;
+}
+
+int EntityHandleMap::Get(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	auto index = self->handles_.Find(get<EntityHandle>(L, 2));
+	if (index) {
+		lua_getuservalue(L, 1);
+		lua_rawgeti(L, -1, *index + 1);
+		lua_remove(L, -2);
+	} else {
+		push(L, nullptr);
+	}
+
+	return 1;
+}
+
+int EntityHandleMap::Set(lua_State* L)
+{
+	StackCheck _(L, 0);
+	auto self = CheckUserData(L, 1);
+	auto handle = get<EntityHandle>(L, 2);
+	lua_getuservalue(L, 1);
+	auto valuesIdx = lua_absindex(L, -1);
+
+	if (lua_isnoneornil(L, 3)) {
+		auto index = self->handles_.Remove(handle);
+		if (index) {
+			self->RemoveValue(L, valuesIdx, *index);
+		}
+	} else {
+		auto index = self->handles_.Insert(handle).first;
+		lua_pushvalue(L, 3);
+		lua_rawseti(L, valuesIdx, index + 1);
+	}
+
+	lua_pop(L, 1);
+	return 0;
+}
+
+int EntityHandleMap::Remove(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	auto index = self->handles_.Remove(get<EntityHandle>(L, 2));
+	if (index) {
+		lua_getuservalue(L, 1);
+		self->RemoveValue(L, lua_absindex(L, -1), *index);
+		lua_pop(L, 1);
+	}
+
+	push(L, (bool)index);
+	return 1;
+}
+
+int EntityHandleMap::Clear(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	self->handles_.Clear();
+	lua_newtable(L);
+	lua_setuservalue(L, 1);
+	return 0;
+}
+
+int EntityHandleMap::Keys(lua_State* L)
+{
+	auto self = CheckUserData(L, 1);
+	lua_createtable(L, (int)self->handles_.Size(), 0);
+	for (uint32_t i = 0; i < self->handles_.Size(); i++) {
+		push(L, self->handles_[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+END_NS()
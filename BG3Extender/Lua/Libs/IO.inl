@@ -16,11 +16,65 @@ std::optional<STDString> LoadFile(char const* path, std::optional<FixedString> c
 	}
 }
 
+/// <summary>
+/// Loads a file from the user profile directory if it was modified since it was last loaded.
+/// Unchanged files are not read again, so this is considerably cheaper than LoadFile() for polling.
+/// ```lua
+/// local contents, version = Ext.IO.LoadFileIfChanged("MyMod/Config.json", lastVersion)
+/// if contents ~= nil then
+///     lastVersion = version
+///     -- Reload config
+/// end
+/// ```
+/// </summary>
+/// <param name="path">Path of the file, relative to the user profile Script Extender directory</param>
+/// <param name="version">Version returned by a previous call, or nil to load the file unconditionally</param>
+/// <returns>File contents (nil if the file is unchanged or missing) and the current version (nil if the file is missing)</returns>
+UserReturn LoadFileIfChanged(lua_State* L, char const* path, std::optional<int64_t> version)
+{
+	std::optional<STDString> contents;
+	auto currentVersion = script::LoadExternalFileIfChanged(path, PathRootType::UserProfile, (uint64_t)version.value_or(0), contents);
+	push(L, contents);
+	if (currentVersion) {
+		push(L, (int64_t)*currentVersion);
+	} else {
+		push(L, nullptr);
+	}
+
+	return 2;
+}
+
+/// <summary>
+/// Saves a file to the Script Extender directory of the user profile.
+/// </summary>
+/// <returns>Whether the file was written</returns>
 bool SaveFile(char const* path, char const* contents)
 {
 	return script::SaveExternalFile(path, PathRootType::UserProfile, contents);
 }
 
+/// <summary>
+/// Saves a file to the Script Extender directory of the user profile on a background thread.
+/// Saving the same file again before the write completes only writes the latest contents.
+/// LoadFile() returns the queued contents until the file is written.
+/// The return value only indicates whether the path is valid; call Flush() to wait until
+/// the file is on disk and to check whether the write succeeded.
+/// </summary>
+/// <returns>Whether the write was queued</returns>
+bool SaveFileAsync(char const* path, char const* contents)
+{
+	return script::SaveExternalFileAsync(path, PathRootType::UserProfile, contents);
+}
+
+/// <summary>
+/// Waits until all files saved using SaveFileAsync() are written to disk.
+/// </summary>
+/// <returns>Whether all writes since the last flush succeeded</returns>
+bool Flush()
+{
+	return script::FlushExternalFiles();
+}
+
 void AddPathOverride(char const* path, char const* overridePath)
 {
 	gExtender->AddPathOverride(path, overridePath);
@@ -36,7 +90,10 @@ void RegisterIOLib()
 	DECLARE_MODULE(IO, Both)
 	BEGIN_MODULE()
 	MODULE_FUNCTION(LoadFile)
+	MODULE_FUNCTION(LoadFileIfChanged)
 	MODULE_FUNCTION(SaveFile)
+	MODULE_FUNCTION(SaveFileAsync)
+	MODULE_FUNCTION(Flush)
 	MODULE_FUNCTION(AddPathOverride)
 	MODULE_FUNCTION(GetPathOverride)
 	END_MODULE()
@@ -1,7 +1,74 @@
 BEGIN_SE()
 
+TranslatedStringOverlay& GetTranslatedStringOverlay()
+{
+	// Intentionally never destroyed; strings are allocated from the game allocator,
+	// which may already be gone when static destructors run
+	static TranslatedStringOverlay* overlay = new TranslatedStringOverlay();
+	return *overlay;
+}
+
+TranslatedStringOverlay::Shard& TranslatedStringOverlay::GetShard(FixedString const& handle)
+{
+	return shards_[std::hash<FixedString>{}(handle) % NumShards];
+}
+
+std::optional<StringView> TranslatedStringOverlay::Get(RuntimeStringHandle const& handle)
+{
+	auto& shard = GetShard(handle.Handle);
+	std::shared_lock _(shard.Lock);
+	auto it = shard.Texts.find(handle.Handle);
+	if (it != shard.Texts.end()) {
+		return StringView(*it->second);
+	} else {
+		return {};
+	}
+}
+
+void TranslatedStringOverlay::Set(TranslatedStringRepository& repo, RuntimeStringHandle const& handle, StringView translated)
+{
+	auto& shard = GetShard(handle.Handle);
+	std::unique_lock _(shard.Lock);
+	auto it = shard.Texts.find(handle.Handle);
+	if (it != shard.Texts.end() && *it->second == translated) {
+		return;
+	}
+
+	auto text = std::make_unique<STDString>(translated);
+	repo.TranslatedStrings[0]->Texts.Set(handle, LSStringView(text->data(), text->size()));
+
+	// The game pool and earlier Get() callers may still reference the previous string
+	// without holding our lock, so keep it alive until ReleaseRetired() frees it
+	if (it != shard.Texts.end()) {
+		shard.Retired.push_back(std::move(it->second));
+		it->second = std::move(text);
+	} else {
+		shard.Texts.insert(std::make_pair(handle.Handle, std::move(text)));
+	}
+}
+
+void TranslatedStringOverlay::ReleaseRetired()
+{
+	for (auto& shard : shards_) {
+		std::vector<std::unique_ptr<STDString>> released;
+		{
+			std::unique_lock _(shard.Lock);
+			if (shard.Retired.empty() && shard.Expiring.empty()) continue;
+
+			released = std::move(shard.Expiring);
+			shard.Expiring = std::move(shard.Retired);
+			shard.Retired.clear();
+		}
+	}
+}
+
 std::optional<StringView> TranslatedStringRepository::GetTranslatedString(RuntimeStringHandle const& handle)
 {
+	auto overlayText = GetTranslatedStringOverlay().Get(handle);
+	if (overlayText) {
+		return overlayText;
+	}
+
 	auto text = TranslatedStrings[0]->Texts.Find(handle);
 	if (!text) {
 		text = VersionedFallbackPool->Texts.Find(handle);
@@ -15,9 +82,7 @@ std::optional<StringView> TranslatedStringRepository::GetTranslatedString(Runtim
 
 void TranslatedStringRepository::UpdateTranslatedString(RuntimeStringHandle const& handle, StringView translated)
 {
-	auto text = GameAlloc<STDString>(translated);
-	TranslatedStrings[0]->Strings.push_back(text);
-	TranslatedStrings[0]->Texts.Set(handle, LSStringView(text->data(), text->size()));
+	GetTranslatedStringOverlay().Set(*this, handle, translated);
 }
 
 END_SE()
@@ -49,12 +114,41 @@ bool UpdateTranslatedString(FixedString handle, char const* value)
 	return true;
 }
 
+/// <summary>
+/// Updates multiple translated strings in one call.
+/// Useful for loading a whole table of localized strings at once.
+/// 
+/// Example:
+/// ```lua
+/// Ext.Loca.UpdateTranslatedStrings({
+///     h12345678g1234g4567g8901g123456789012 = "First string",
+///     h87654321g4321g7654g1098g210987654321 = "Second string"
+/// })
+/// ```
+/// </summary>
+/// <param name="strings">Map of translated string handles to their new text</param>
+/// <returns>Number of strings updated</returns>
+uint32_t UpdateTranslatedStrings(MultiHashMap<FixedString, STDString> strings)
+{
+	auto repo = GetStaticSymbols().GetTranslatedStringRepository();
+	if (!repo) return 0;
+
+	uint32_t updated{ 0 };
+	for (auto const& it : strings) {
+		repo->UpdateTranslatedString(RuntimeStringHandle(it.Key(), 0), it.Value());
+		updated++;
+	}
+
+	return updated;
+}
+
 void RegisterLocalizationLib()
 {
 	DECLARE_MODULE(Loca, Both)
 	BEGIN_MODULE()
 	MODULE_FUNCTION(GetTranslatedString)
 	MODULE_FUNCTION(UpdateTranslatedString)
+	MODULE_FUNCTION(UpdateTranslatedStrings)
 	END_MODULE()
 }
 
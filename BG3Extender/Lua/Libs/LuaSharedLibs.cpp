@@ -4,6 +4,7 @@
 #include <Lua/Shared/LuaMethodCallHelpers.h>
 #include <Lua/Libs/Debug.inl>
 #include <Lua/Libs/Entity.inl>
+#include <Lua/Libs/EntityHandleSet.inl>
 #include <Lua/Libs/IO.inl>
 #include <Lua/Libs/Json.inl>
 #include <Lua/Libs/Localization.inl>
@@ -55,12 +56,19 @@ void RegisterSharedMetatables(lua_State* L)
 	UserVariableHolderMetatable::RegisterMetatable(L);
 	ModVariableHolderMetatable::RegisterMetatable(L);
 	EntityProxyMetatable::RegisterMetatable(L);
+	EntityHandleSet::RegisterMetatable(L);
+	EntityHandleMap::RegisterMetatable(L);
 	stats::StatsExtraDataProxy::RegisterMetatable(L);
 	stats::StatsProxy::RegisterMetatable(L);
 	stats::SpellPrototypeProxy::RegisterMetatable(L);
 	types::RegisterEnumerations(L);
 }
 
+void RegisterSharedInternals(lua_State* L)
+{
+	debug::RegisterInternalDebugLib(L);
+}
+
 void RegisterSharedLibraries()
 {
 	utils::RegisterUtilsLib();
@@ -17,12 +17,7 @@ bool IsModLoaded(char const* modNameGuid)
 {
 	auto modUuid = Guid::Parse(modNameGuid);
 	if (modUuid) {
-		auto modManager = gExtender->GetCurrentExtensionState()->GetModManager();
-		for (auto const& mod : modManager->BaseModule.LoadOrderedModules) {
-			if (mod.Info.ModuleUUID == *modUuid) {
-				return true;
-			}
-		}
+		return gExtender->GetCurrentExtensionState()->GetLoadedMod(*modUuid) != nullptr;
 	}
 
 	return false;
@@ -34,14 +29,7 @@ bool IsModLoaded(char const* modNameGuid)
 /// <returns></returns>
 ObjectSet<Guid> GetLoadOrder()
 {
-	ObjectSet<Guid> loadOrder;
-	auto modManager = gExtender->GetCurrentExtensionState()->GetModManager();
-
-	for (auto const& mod : modManager->BaseModule.LoadOrderedModules) {
-		loadOrder.Add(mod.Info.ModuleUUID);
-	}
-
-	return loadOrder;
+	return gExtender->GetCurrentExtensionState()->GetLoadOrder();
 }
 
 /// <summary>
@@ -50,15 +38,9 @@ ObjectSet<Guid> GetLoadOrder()
 /// <param name="modNameGuid">Mod UUID to query</param>
 Module* GetMod(char const* modNameGuid)
 {
-	Module const * module{ nullptr };
 	auto modUuid = Guid::Parse(modNameGuid);
 	if (modUuid) {
-		auto modManager = gExtender->GetCurrentExtensionState()->GetModManager();
-		for (auto& mod : modManager->BaseModule.LoadOrderedModules) {
-			if (mod.Info.ModuleUUID == *modUuid) {
-				return &mod;
-			}
-		}
+		return gExtender->GetCurrentExtensionState()->GetLoadedMod(*modUuid);
 	}
 
 	return nullptr;
@@ -75,20 +75,162 @@ GameObjectTemplate* GetLocalCacheTemplate(FixedString const& templateId)
 	return nullptr;
 }
 
-GameObjectTemplate* GetTemplate(FixedString const& templateId)
+// Remembers which template manager each template ID was resolved from, so that repeated
+// lookups only probe that manager instead of walking the whole root/local/cache chain.
+// Root and local templates only change when a session or level is loaded; the cache is flushed
+// by InvalidateTemplateCache() on session load and whenever a template manager is replaced.
+// Cache templates are created and destroyed at any time, so IDs that weren't found in the
+// root or local templates are always looked up again in the cache template managers.
+class TemplateResolutionCache
 {
-	auto tmpl = GetRootTemplate(templateId);
-	if (!tmpl) {
-		tmpl = GetLocalTemplate(templateId);
-		if (!tmpl) {
-			tmpl = GetCacheTemplate(templateId);
-			if (!tmpl) {
-				tmpl = GetLocalCacheTemplate(templateId);
+public:
+	enum class Source : uint8_t
+	{
+		None,
+		Root,
+		Local,
+		Cache,
+		LocalCache
+	};
+
+	void Invalidate()
+	{
+		valid_ = false;
+	}
+
+	// Must be called before a batch of Resolve() calls to flush outdated entries
+	void Validate()
+	{
+		auto managers = GetManagers();
+		if (!valid_ || managers != managers_) {
+			sources_.clear();
+			managers_ = managers;
+			valid_ = true;
+		}
+	}
+
+	GameObjectTemplate* Resolve(FixedString const& templateId)
+	{
+		auto source = sources_.Find(templateId);
+		if (source && (**source == Source::Root || **source == Source::Local)) {
+			return Probe(**source, templateId);
+		}
+
+		if (!source) {
+			if (sources_.size() >= MaxCachedIds) {
+				sources_.clear();
 			}
+
+			for (auto src : { Source::Root, Source::Local }) {
+				auto tmpl = Probe(src, templateId);
+				if (tmpl) {
+					sources_.Set(templateId, src);
+					return tmpl;
+				}
+			}
+		}
+
+		for (auto src : { Source::Cache, Source::LocalCache }) {
+			auto tmpl = Probe(src, templateId);
+			if (tmpl) {
+				sources_.Set(templateId, src);
+				return tmpl;
+			}
+		}
+
+		sources_.Set(templateId, Source::None);
+		return nullptr;
+	}
+
+private:
+	static constexpr uint32_t MaxCachedIds = 0x10000;
+
+	struct Managers
+	{
+		void const* RootBank{ nullptr };
+		void const* LocalManager{ nullptr };
+		void const* CacheManager{ nullptr };
+		void const* LocalCacheManager{ nullptr };
+
+		inline bool operator != (Managers const& o) const
+		{
+			return RootBank != o.RootBank
+				|| LocalManager != o.LocalManager
+				|| CacheManager != o.CacheManager
+				|| LocalCacheManager != o.LocalCacheManager;
+		}
+	};
+
+	bool valid_{ false };
+	Managers managers_;
+	MultiHashMap<FixedString, Source> sources_;
+
+	Managers GetManagers() const
+	{
+		Managers managers;
+		managers.RootBank = GetStaticSymbols().GetGlobalTemplateBank();
+		managers.CacheManager = *GetStaticSymbols().esv__CacheTemplateManager;
+
+		auto level = GetStaticSymbols().GetCurrentServerLevel();
+		if (level) {
+			managers.LocalManager = level->LocalTemplateManager;
+			managers.LocalCacheManager = level->CacheTemplateManager;
+		}
+
+		return managers;
+	}
+
+	GameObjectTemplate* Probe(Source source, FixedString const& templateId)
+	{
+		switch (source) {
+		case Source::Root: return GetRootTemplate(templateId);
+		case Source::Local: return GetLocalTemplate(templateId);
+		case Source::Cache: return GetCacheTemplate(templateId);
+		case Source::LocalCache: return GetLocalCacheTemplate(templateId);
+		default: return nullptr;
+		}
+	}
+};
+
+// Only used from the server Lua state, so no locking is needed
+TemplateResolutionCache gTemplateResolutionCache;
+
+void InvalidateTemplateCache()
+{
+	gTemplateResolutionCache.Invalidate();
+}
+
+/// <summary>
+/// Returns the template with the specified ID.
+/// Root templates are checked first, followed by the local, cache and level cache templates.
+/// </summary>
+/// <param name="templateId">Template ID to look up</param>
+GameObjectTemplate* GetTemplate(FixedString const& templateId)
+{
+	gTemplateResolutionCache.Validate();
+	return gTemplateResolutionCache.Resolve(templateId);
+}
+
+/// <summary>
+/// Resolves multiple templates in one call; see GetTemplate() for the lookup order.
+/// </summary>
+/// <param name="templateIds">Template IDs to look up</param>
+/// <returns>Table of template ID -> template; IDs that don't exist are not included</returns>
+UserReturn GetTemplates(lua_State* L, Array<FixedString> templateIds)
+{
+	gTemplateResolutionCache.Validate();
+
+	lua_createtable(L, 0, (int)templateIds.size());
+	for (auto const& templateId : templateIds) {
+		auto tmpl = gTemplateResolutionCache.Resolve(templateId);
+		if (tmpl) {
+			push(L, templateId);
+			MakeObjectRef(L, tmpl);
+			lua_rawset(L, -3);
 		}
 	}
 
-	return tmpl;
+	return 1;
 }
 
 void RegisterTemplateLib()
@@ -96,6 +238,7 @@ void RegisterTemplateLib()
 	DECLARE_MODULE(Template, Server)
 	BEGIN_MODULE()
 	MODULE_FUNCTION(GetTemplate)
+	MODULE_FUNCTION(GetTemplates)
 	MODULE_FUNCTION(GetAllRootTemplates)
 	MODULE_FUNCTION(GetRootTemplate)
 	MODULE_FUNCTION(GetAllLocalTemplates)
@@ -103,25 +103,22 @@ Array<FixedString> FetchTreasureCategoryEntries(RPGStats* stats)
 
 Array<FixedString> FetchStatEntries(RPGStats * stats, FixedString const& statType)
 {
-	ModifierList* modifierList{ nullptr };
+	Array<FixedString> names;
 	if (statType) {
-		modifierList = stats->ModifierLists.Find(statType);
-		if (modifierList == nullptr) {
+		auto modifierListIndex = stats->ModifierLists.FindIndex(statType);
+		if (!modifierListIndex) {
 			OsiError("Unknown stats entry type: " << statType);
 			return {};
 		}
-	}
 
-	Array<FixedString> names;
-	for (auto object : stats->Objects.Primitives) {
-		if (statType) {
-			auto type = stats->GetTypeInfo(object);
-			if (modifierList != nullptr && type != modifierList) {
-				continue;
-			}
+		auto entries = gExtender->GetStatLoadOrderHelper().GetStatsOfType((uint32_t)*modifierListIndex);
+		for (auto object : entries) {
+			names.push_back(object->Name);
+		}
+	} else {
+		for (auto object : stats->Objects.Primitives) {
+			names.push_back(object->Name);
 		}
-
-		names.push_back(object->Name);
 	}
 
 	return names;
@@ -129,26 +126,21 @@ Array<FixedString> FetchStatEntries(RPGStats * stats, FixedString const& statTyp
 
 Array<FixedString> FetchStatEntriesBefore(RPGStats* stats, FixedString const& modId, std::optional<FixedString> statType)
 {
-	ModifierList* modifierList{ nullptr };
+	std::optional<uint32_t> modifierListIndex;
 	if (statType) {
-		modifierList = stats->ModifierLists.Find(*statType);
-		if (modifierList == nullptr) {
+		auto index = stats->ModifierLists.FindIndex(*statType);
+		if (!index) {
 			OsiError("Unknown stats entry type: " << *statType);
 			return {};
 		}
+
+		modifierListIndex = (uint32_t)*index;
 	}
 
-	auto entries = gExtender->GetStatLoadOrderHelper().GetStatsLoadedBefore(modId);
+	auto entries = gExtender->GetStatLoadOrderHelper().GetStatsLoadedBefore(modId, modifierListIndex);
 
 	Array<FixedString> names;
 	for (auto object : entries) {
-		if (statType) {
-			auto type = stats->GetTypeInfo(object);
-			if (modifierList != nullptr && type != modifierList) {
-				continue;
-			}
-		}
-
 		names.push_back(object->Name);
 	}
 
@@ -765,6 +757,77 @@ std::optional<int32_t> AddEnumerationValue(FixedString const& typeName, FixedStr
 	return value;
 }
 
+/// <summary>
+/// Returns statistics about the condition expressions used by stats entries.
+/// Identical condition strings are stored only once; the returned table contains the number of unique
+/// condition strings (`Unique`), the total number of references to them from stats entries (`References`)
+/// and the number of references to each condition string (`Conditions`, keyed by condition text).
+/// </summary>
+/// <lua_export>GetConditionStatistics</lua_export>
+/// <returns></returns>
+UserReturn GetConditionStatistics(lua_State* L)
+{
+	auto stats = GetStaticSymbols().GetStats();
+	if (stats == nullptr) {
+		OsiError("RPGStats not available");
+		push(L, nullptr);
+		return 1;
+	}
+
+	// Attribute indices of condition-typed attributes in each modifier list
+	std::vector<std::vector<uint32_t>> conditionAttributes(stats->ModifierLists.Primitives.Size());
+	for (uint32_t i = 0; i < stats->ModifierLists.Primitives.Size(); i++) {
+		auto const& attributes = stats->ModifierLists.Primitives[i]->Attributes.Primitives;
+		for (uint32_t j = 0; j < attributes.Size(); j++) {
+			auto typeInfo = stats->ModifierValueLists.Find(attributes[j]->EnumerationIndex);
+			if (typeInfo != nullptr && (typeInfo->Name == GFS.strConditions
+				|| typeInfo->Name == GFS.strTargetConditions
+				|| typeInfo->Name == GFS.strUseConditions)) {
+				conditionAttributes[i].push_back(j);
+			}
+		}
+	}
+
+	std::vector<uint32_t> references(stats->Conditions.Size());
+	uint32_t totalReferences{ 0 };
+	auto addReference = [&](int32_t conditionsId) {
+		if (conditionsId >= 0 && conditionsId < (int32_t)references.size()) {
+			references[conditionsId]++;
+			totalReferences++;
+		}
+	};
+
+	for (auto object : stats->Objects.Primitives) {
+		if (object->ModifierListIndex < conditionAttributes.size()) {
+			for (auto attributeIndex : conditionAttributes[object->ModifierListIndex]) {
+				if (attributeIndex < object->IndexedProperties.size()) {
+					addReference(object->IndexedProperties[attributeIndex]);
+				}
+			}
+		}
+
+		for (auto const& conditions : object->RollConditions) {
+			for (auto const& roll : conditions.Value()) {
+				addReference(roll.ConditionsId);
+			}
+		}
+	}
+
+	uint32_t unique{ 0 };
+	lua_newtable(L);
+	lua_newtable(L);
+	for (uint32_t i = 0; i < references.size(); i++) {
+		if (references[i] > 0) {
+			settable(L, stats->Conditions[i], references[i]);
+			unique++;
+		}
+	}
+	lua_setfield(L, -2, "Conditions");
+	setfield(L, "Unique", unique);
+	setfield(L, "References", totalReferences);
+	return 1;
+}
+
 void RegisterStatsLib()
 {
 	DECLARE_MODULE(Stats, Both)
@@ -782,6 +845,7 @@ void RegisterStatsLib()
 	MODULE_FUNCTION(EnumLabelToIndex)
 	MODULE_FUNCTION(AddAttribute)
 	MODULE_FUNCTION(AddEnumerationValue)
+	MODULE_FUNCTION(GetConditionStatistics)
 	END_MODULE()
 		
 /*	DECLARE_SUBMODULE(Stats, SkillSet, Both)
@@ -167,6 +167,34 @@ EntityHandle IntegerToHandle(int64_t i)
 	return EntityHandle(i);
 }
 
+/// <summary>
+/// Creates a set of entity handles.
+/// Membership tests on the set don't require converting entities to table keys, which makes it suitable
+/// for keeping large sets of entities (eg. aggro lists or caches).
+/// </summary>
+/// <param name="entities">Array of entities, handle set or handle map to initialize the set with</param>
+UserReturn CreateHandleSet(lua_State* L)
+{
+	auto initIdx = lua_gettop(L) >= 1 && !lua_isnil(L, 1) ? 1 : 0;
+	auto set = EntityHandleSet::Make(L);
+	if (initIdx) {
+		ForEachHandleIn(L, initIdx, [set](EntityHandle handle) {
+			set->Handles().Insert(handle);
+		});
+	}
+
+	return 1;
+}
+
+/// <summary>
+/// Creates a map with entity handle keys and arbitrary Lua values.
+/// </summary>
+UserReturn CreateHandleMap(lua_State* L)
+{
+	EntityHandleMap::Make(L);
+	return 1;
+}
+
 STDString GetValueType(lua_State* L)
 {
 	if (lua_type(L, 1) == LUA_TLIGHTUSERDATA) {
@@ -232,6 +260,8 @@ void RegisterUtilsLib()
 	MODULE_FUNCTION(IsValidHandle)
 	MODULE_FUNCTION(HandleToInteger)
 	MODULE_FUNCTION(IntegerToHandle)
+	MODULE_FUNCTION(CreateHandleSet)
+	MODULE_FUNCTION(CreateHandleMap)
 	MODULE_FUNCTION(ShowErrorAndExitGame)
 	MODULE_FUNCTION(ShowError)
 	MODULE_FUNCTION(GetGlobalSwitches)
@@ -128,34 +128,25 @@ namespace bg3se::lua
 
 	void PushExtFunction(lua_State * L, char const * func)
 	{
-		lua_getglobal(L, "Ext"); // stack: Ext
-		lua_getfield(L, -1, func); // stack: Ext, fn
-		lua_remove(L, -2); // stack: fn
+		State::FromLua(L)->PushExtFunction(L, func);
 	}
 
 
 	void PushInternalFunction(lua_State* L, char const* func)
 	{
-		lua_getglobal(L, "Ext"); // stack: Ext
-		lua_getfield(L, -1, "_Internal"); // stack: Ext, _Internal
-		lua_remove(L, -2); // stack: _I
-		lua_getfield(L, -1, func); // stack: _I, fn
-		lua_remove(L, -2); // stack: fn
+		State::FromLua(L)->PushInternalFunction(L, func);
 	}
 
 
 	void PushModFunction(lua_State* L, char const* mod, char const* func)
 	{
-		lua_getglobal(L, "Mods"); // stack: Mods
-		lua_getfield(L, -1, mod); // stack: Mods, mod
-		lua_remove(L, -2); // stack: mod
-		lua_getfield(L, -1, func); // stack: mod, fn
-		lua_remove(L, -2); // stack: fn
+		State::FromLua(L)->PushModFunction(L, mod, func);
 	}
 
 	void ExtensionLibrary::Register(lua_State * L)
 	{
 		RegisterLib(L);
+		RegisterSharedInternals(L);
 	}
 
 
@@ -219,23 +210,6 @@ namespace bg3se::lua
 		throw Exception(err);
 	}
 
-	void* LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
-	{
-		(void)ud; (void)osize;  /* not used */
-		if (nsize == 0) {
-			GameFree(ptr);
-			return NULL;
-		} else {
-			auto newBuf = GameAllocRaw(nsize);
-			if (ptr != nullptr) {
-				memcpy(newBuf, ptr, std::min(nsize, osize));
-				GameFree(ptr);
-			}
-
-			return newBuf;
-		}
-	}
-
 	LifetimeHandle GetCurrentLifetime(lua_State* L)
 	{
 		return State::FromLua(L)->GetCurrentLifetime();
@@ -248,7 +222,7 @@ namespace bg3se::lua
 		variableManager_(isServer ? gExtender->GetServer().GetExtensionState().GetUserVariables() : gExtender->GetClient().GetExtensionState().GetUserVariables(), isServer),
 		modVariableManager_(isServer ? gExtender->GetServer().GetExtensionState().GetModVariables() : gExtender->GetClient().GetExtensionState().GetModVariables(), isServer)
 	{
-		L = lua_newstate(LuaAlloc, nullptr);
+		L = lua_newstate(&LuaAllocator::LuaAlloc, &allocator_);
 		internal_ = lua_new_internal_state();
 		lua_setup_cppobjects(L, &LuaCppAlloc, &LuaCppFree, &LuaCppGetLightMetatable, &LuaCppGetMetatable, &LuaCppCanonicalize);
 		lua_setup_strcache(L, &LuaCacheString, &LuaReleaseString);
@@ -266,6 +240,99 @@ namespace bg3se::lua
 		lua_close(L);
 	}
 
+	void State::PushModFunction(lua_State* L, char const* mod, char const* func)
+	{
+		modFunctionKey_ = mod;
+		modFunctionKey_.push_back('\0');
+		modFunctionKey_ += func;
+
+		auto it = modFunctions_.find(modFunctionKey_);
+		if (it == modFunctions_.end()) {
+			ModFunctionRef ref;
+			lua_pushstring(L, mod);
+			ref.ModName = luaL_ref(L, LUA_REGISTRYINDEX);
+			lua_pushstring(L, func);
+			ref.Name = luaL_ref(L, LUA_REGISTRYINDEX);
+			it = modFunctions_.insert(std::make_pair(modFunctionKey_, ref)).first;
+		}
+
+		// Neither the mod table nor the function is cached, as mods may reassign Mods[mod] or
+		// the function at any time; lookups with the interned names pick up the current values
+		lua_getglobal(L, "Mods"); // stack: Mods
+		lua_rawgeti(L, LUA_REGISTRYINDEX, it->second.ModName); // stack: Mods, modName
+		lua_gettable(L, -2); // stack: Mods, mod
+		lua_remove(L, -2); // stack: mod
+		if (lua_type(L, -1) == LUA_TTABLE) {
+			lua_rawgeti(L, LUA_REGISTRYINDEX, it->second.Name); // stack: mod, name
+			if (lua_rawget(L, -2) != LUA_TNIL) { // stack: mod, fn
+				lua_remove(L, -2); // stack: fn
+				return;
+			}
+
+			lua_pop(L, 1); // stack: mod
+		}
+
+		// Not defined in the mod table; go through __index (i.e. globals)
+		lua_rawgeti(L, LUA_REGISTRYINDEX, it->second.Name); // stack: mod, name
+		lua_gettable(L, -2); // stack: mod, fn
+		lua_remove(L, -2); // stack: fn
+	}
+
+	void State::PushCachedGlobalTable(lua_State* L, int& ref, int parentRef, char const* name)
+	{
+		if (ref != LUA_NOREF) {
+			lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+			return;
+		}
+
+		if (parentRef == 0) {
+			lua_getglobal(L, name); // stack: tab
+		} else {
+			lua_rawgeti(L, LUA_REGISTRYINDEX, parentRef); // stack: parent
+			lua_getfield(L, -1, name); // stack: parent, tab
+			lua_remove(L, -2); // stack: tab
+		}
+
+		// Not created yet during early startup; look it up again next time
+		if (lua_istable(L, -1)) {
+			lua_pushvalue(L, -1);
+			ref = luaL_ref(L, LUA_REGISTRYINDEX);
+		}
+	}
+
+	void State::PushExtFunction(lua_State* L, char const* func)
+	{
+		PushCachedGlobalTable(L, extTableRef_, 0, "Ext"); // stack: Ext
+		lua_getfield(L, -1, func); // stack: Ext, fn
+		lua_remove(L, -2); // stack: fn
+	}
+
+	void State::PushInternalFunction(lua_State* L, char const* func)
+	{
+		if (startupDone_) {
+			internalFunctionKey_ = func;
+			auto it = internalFunctions_.find(internalFunctionKey_);
+			if (it != internalFunctions_.end()) {
+				lua_rawgeti(L, LUA_REGISTRYINDEX, it->second); // stack: fn
+				return;
+			}
+		}
+
+		if (internalTableRef_ == LUA_NOREF) {
+			PushCachedGlobalTable(L, extTableRef_, 0, "Ext"); // stack: Ext
+			lua_pop(L, 1); // stack: -
+		}
+
+		PushCachedGlobalTable(L, internalTableRef_, extTableRef_, "_Internal"); // stack: _I
+		lua_getfield(L, -1, func); // stack: _I, fn
+		lua_remove(L, -2); // stack: fn
+
+		if (startupDone_ && lua_isfunction(L, -1)) {
+			lua_pushvalue(L, -1);
+			internalFunctions_.insert(std::make_pair(internalFunctionKey_, luaL_ref(L, LUA_REGISTRYINDEX)));
+		}
+	}
+
 	void State::Shutdown()
 	{
 		variableManager_.Invalidate();
@@ -343,6 +410,93 @@ namespace bg3se::lua
 			return {};
 		}
 
+		return RunLoadedScript(top, globalsIdx);
+	}
+
+	int LuaDumpToString(lua_State* L, const void* p, size_t sz, void* ud)
+	{
+		reinterpret_cast<STDString*>(ud)->append(reinterpret_cast<char const*>(p), sz);
+		return 0;
+	}
+
+	std::optional<int> State::LoadCompiledScript(STDString const& bytecode, STDString const& name, int globalsIdx)
+	{
+		int top = lua_gettop(L);
+
+		int status = luaL_loadbufferx(L, bytecode.c_str(), bytecode.size(), name.c_str(), "binary");
+		if (status != LUA_OK) {
+			LuaError("Failed to load precompiled script: " << lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return {};
+		}
+
+		return RunLoadedScript(top, globalsIdx);
+	}
+
+	std::optional<int> State::LoadBuiltinScript(LuaBundle& bundle, STDString const& path, STDString const& script, STDString const& name, int globalsIdx)
+	{
+		int top = lua_gettop(L);
+
+		auto bytecode = bundle.GetCompiledChunk(path, script);
+		if (bytecode) {
+			// Binary chunks are only accepted from the compiled chunk cache, never from script files
+			int status = luaL_loadbufferx(L, bytecode->c_str(), bytecode->size(), name.c_str(), "binary");
+			if (status != LUA_OK) {
+				// The cached chunk is replaced by the one compiled below
+				WARN("Failed to load precompiled script '%s', compiling from source: %s", name.c_str(), lua_tostring(L, -1));
+				lua_pop(L, 1);
+				bytecode.reset();
+			}
+		}
+
+		if (!bytecode) {
+			int status = luaL_loadbufferx(L, script.c_str(), script.size(), name.c_str(), "text");
+			if (status != LUA_OK) {
+				LuaError("Failed to parse script: " << lua_tostring(L, -1));
+				lua_pop(L, 1);
+				return {};
+			}
+
+			// Debug info is kept so that tracebacks still point at the builtin script
+			STDString compiled;
+			if (lua_dump(L, &LuaDumpToString, &compiled, 0) == 0) {
+				bundle.SetCompiledChunk(path, script, std::move(compiled));
+			}
+		}
+
+		return RunLoadedScript(top, globalsIdx);
+	}
+
+	ScriptCompiler::ScriptCompiler()
+	{
+		L_ = lua_newstate(&LuaAllocator::LuaAlloc, &allocator_);
+		lua_setup_cppobjects(L_, &LuaCppAlloc, &LuaCppFree, &LuaCppGetLightMetatable, &LuaCppGetMetatable, &LuaCppCanonicalize);
+		lua_setup_strcache(L_, &LuaCacheString, &LuaReleaseString);
+		lua_atpanic(L_, &LuaPanic);
+	}
+
+	ScriptCompiler::~ScriptCompiler()
+	{
+		lua_close(L_);
+	}
+
+	bool ScriptCompiler::Compile(StringView source, STDString const& name, STDString& bytecode)
+	{
+		bytecode.clear();
+		int status = luaL_loadbufferx(L_, source.data(), source.size(), name.c_str(), "text");
+		if (status != LUA_OK) {
+			bytecode = lua_tostring(L_, -1);
+			lua_pop(L_, 1);
+			return false;
+		}
+
+		auto ok = lua_dump(L_, &LuaDumpToString, &bytecode, 0) == 0;
+		lua_pop(L_, 1);
+		return ok;
+	}
+
+	std::optional<int> State::RunLoadedScript(int top, int globalsIdx)
+	{
 #if LUA_VERSION_NUM <= 501
 		if (globalsIdx != 0) {
 			lua_pushvalue(L, globalsIdx);
@@ -352,7 +506,8 @@ namespace bg3se::lua
 
 		/* Ask Lua to run our little script */
 		LifetimeStackPin _(lifetimeStack_);
-		status = CallWithTraceback(L, 0, LUA_MULTRET);
+		ModProfiler::Scope profile(modProfiler_, modProfiler_.GetOwner(L, -1));
+		int status = CallWithTraceback(L, 0, LUA_MULTRET);
 		if (status != LUA_OK) {
 			LuaError("Failed to execute script: " << lua_tostring(L, -1));
 			lua_pop(L, 1); // pop error message from the stack
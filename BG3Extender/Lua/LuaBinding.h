@@ -2,6 +2,8 @@
 
 #include <Lua/LuaHelpers.h>
 #include <Lua/Shared/LuaLifetime.h>
+#include <Lua/Shared/LuaAllocator.h>
+#include <Lua/Shared/LuaModProfiler.h>
 #include <Lua/Shared/Proxies/LuaObjectProxy.h>
 #include <Lua/Shared/Proxies/LuaEvent.h>
 #include <Lua/Shared/Proxies/LuaEntityProxy.h>
@@ -15,16 +17,22 @@
 #include <Extender/Shared/UserVariables.h>
 
 #include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <optional>
 
 namespace bg3se::lua
 {
+	class LuaBundle;
+
 	void PushExtFunction(lua_State * L, char const * func);
 	void PushInternalFunction(lua_State * L, char const * func);
 	void PushModFunction(lua_State* L, char const* mod, char const* func);
 	LifetimeHandle GetCurrentLifetime();
 
+	// Registers the native functions of Ext._Internal
+	void RegisterSharedInternals(lua_State* L);
+
 	class ExtensionLibrary
 	{
 	public:
@@ -119,6 +127,39 @@ namespace bg3se::lua
 			return metatableManager_;
 		}
 
+		inline LuaAllocator& GetAllocator()
+		{
+			return allocator_;
+		}
+
+		inline ModProfiler& GetModProfiler()
+		{
+			return modProfiler_;
+		}
+
+		// Pushes Mods[mod][func] onto the stack of the specified thread
+		void PushModFunction(lua_State* L, char const* mod, char const* func);
+
+		inline void PushModFunction(char const* mod, char const* func)
+		{
+			PushModFunction(L, mod, func);
+		}
+
+		// Pushes Ext[func] onto the stack of the specified thread
+		void PushExtFunction(lua_State* L, char const* func);
+		// Pushes Ext._Internal[func] onto the stack of the specified thread
+		void PushInternalFunction(lua_State* L, char const* func);
+
+		inline void PushExtFunction(char const* func)
+		{
+			PushExtFunction(L, func);
+		}
+
+		inline void PushInternalFunction(char const* func)
+		{
+			PushInternalFunction(L, func);
+		}
+
 		inline CachedUserVariableManager& GetVariableManager()
 		{
 			return variableManager_;
@@ -157,7 +198,7 @@ namespace bg3se::lua
 			// FIXME - Restriction restriction(*this, restrictions);
 			LifetimeStackPin _p(lifetimeStack_);
 			auto lifetime = lifetimeStack_.GetCurrent();
-			PushInternalFunction(L, func);
+			PushInternalFunction(func);
 			(push(L, args, lifetime), ...);
 			return CheckedCall<Ret...>(L, sizeof...(args), ret, func);
 		}
@@ -169,7 +210,7 @@ namespace bg3se::lua
 			// FIXME - Restriction restriction(*this, restrictions);
 			LifetimeStackPin _p(lifetimeStack_);
 			auto lifetime = lifetimeStack_.GetCurrent();
-			PushInternalFunction(L, func);
+			PushInternalFunction(func);
 			(push(L, args, lifetime), ...);
 			return CheckedCall(L, sizeof...(args), func);
 		}
@@ -180,18 +221,25 @@ namespace bg3se::lua
 			static_assert(std::is_base_of_v<EventBase, TEvent>, "Event object must be a descendant of EventBase");
 			StackCheck _(L, 0);
 			LifetimeStackPin _p(GetStack());
-			PushInternalFunction(L, "_ThrowEvent");
+			PushInternalFunction("_ThrowEvent");
 			MakeObjectRef(L, &evt);
 			return DispatchEvent(evt, eventName, canPreventAction, restrictions);
 		}
 
 		std::optional<int> LoadScript(STDString const & script, STDString const & name = "", int globalsIdx = 0);
+		// Runs a chunk compiled by a ScriptCompiler
+		std::optional<int> LoadCompiledScript(STDString const& bytecode, STDString const& name, int globalsIdx = 0);
+		// Loads a builtin script, using the chunk compiled by a previous Lua state if the source is unchanged
+		std::optional<int> LoadBuiltinScript(LuaBundle& bundle, STDString const& path, STDString const& script, STDString const& name, int globalsIdx = 0);
 
 		/*void OnNetMessageReceived(STDString const & channel, STDString const & payload, UserId userId);*/
 
 		static STDString GetBuiltinLibrary(int resourceId);
 
 	protected:
+		// Must outlive the Lua state, so it is declared before (and destroyed after) everything else
+		LuaAllocator allocator_;
+		ModProfiler modProfiler_{ allocator_ };
 		lua_State * L;
 		LuaInternalState* internal_{ nullptr };
 		bool startupDone_{ false };
@@ -206,10 +254,49 @@ namespace bg3se::lua
 		CachedUserVariableManager variableManager_;
 		CachedModVariableManager modVariableManager_;
 
+		// Interned mod and function names used by PushModFunction(), keyed by "mod\0func".
+		// These are plain registry references that go away with the state on reset.
+		struct ModFunctionRef
+		{
+			int ModName;
+			int Name;
+		};
+
+		std::unordered_map<STDString, ModFunctionRef> modFunctions_;
+		STDString modFunctionKey_;
+
+		// Registry references to Ext, Ext._Internal and internal functions; resolved on first use.
+		// Internal functions are only cached after startup, when the builtin library is fully loaded.
+		int extTableRef_{ LUA_NOREF };
+		int internalTableRef_{ LUA_NOREF };
+		std::unordered_map<STDString, int> internalFunctions_;
+		STDString internalFunctionKey_;
+
+		// Pushes parent[name] (or the global if parentRef is 0) and caches it in ref if it is a table
+		void PushCachedGlobalTable(lua_State* L, int& ref, int parentRef, char const* name);
+
 		void OpenLibs();
+		std::optional<int> RunLoadedScript(int top, int globalsIdx);
 		EventResult DispatchEvent(EventBase& evt, char const* eventName, bool canPreventAction, uint32_t restrictions);
 	};
 
+	// Bare Lua state for compiling scripts away from the state (and thread) that runs them.
+	// Only parses and dumps chunks; scripts are never executed in it.
+	class ScriptCompiler : Noncopyable<ScriptCompiler>
+	{
+	public:
+		ScriptCompiler();
+		~ScriptCompiler();
+
+		// Compiles the script and dumps the chunk (with debug info) to bytecode;
+		// on failure, bytecode holds the parser error instead
+		bool Compile(StringView source, STDString const& name, STDString& bytecode);
+
+	private:
+		LuaAllocator allocator_;
+		lua_State* L_;
+	};
+
 	class Restriction
 	{
 	public:
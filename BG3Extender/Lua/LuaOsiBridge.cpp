@@ -403,6 +403,30 @@ namespace bg3se::esv::lua
 		return 0;
 	}
 
+	int OsiFunction::LuaModifyMany(lua_State * L, int rowsIdx, bool deleteTuples)
+	{
+		if (!IsBound()) {
+			return luaL_error(L, "Attempted to modify an unbound Osiris database");
+		}
+
+		if (!IsDB()) {
+			return luaL_error(L, "Attempted to modify function that's not a database");
+		}
+
+		// User queries are listed with the Database type too, but have no fact list
+		auto node = function_->Node.Get();
+		if (node == nullptr || !node->IsDataNode()) {
+			return luaL_error(L, "Attempted to modify '%s', which is a user query, not a database", function_->Signature->Name);
+		}
+
+		if (state_->RestrictionFlags & State::RestrictOsiris) {
+			return luaL_error(L, "Attempted to modify Osiris database in restricted context");
+		}
+
+		push(L, OsiInsertMany(L, rowsIdx, deleteTuples));
+		return 1;
+	}
+
 	int OsiFunction::LuaDeferredNotification(lua_State * L)
 	{
 		if (function_ == nullptr) {
@@ -592,6 +616,68 @@ namespace bg3se::esv::lua
 		}
 	}
 
+	uint32_t OsiFunction::OsiInsertMany(lua_State * L, int rowsIdx, bool deleteTuples)
+	{
+		luaL_checktype(L, rowsIdx, LUA_TTABLE);
+		if (function_->Node.Id == 0) {
+			luaL_error(L, "Function has no node");
+		}
+
+		auto funcArgs = function_->Signature->Params->Params.Size;
+		auto numRows = (uint32_t)lua_rawlen(L, rowsIdx);
+		lua_checkstack(L, (int)funcArgs + 1);
+
+		// The tuple is only built once; its values are overwritten for each row
+		OsiArgumentListPin<TypedValue> tvs(state_->Osiris().GetTypedValuePool(), (uint32_t)funcArgs);
+		OsiArgumentListPin<ListNode<TypedValue *>> nodes(state_->Osiris().GetTypedValueNodePool(), (uint32_t)funcArgs + 1);
+
+		TuplePtrLL tuple;
+		auto & args = tuple.Items;
+		args.Init(nodes.Args());
+
+		std::vector<ValueType> types(funcArgs);
+		auto argType = function_->Signature->Params->Params.Head->Next;
+		auto prev = args.Head;
+		for (uint32_t i = 0; i < funcArgs; i++) {
+			types[i] = (ValueType)argType->Item.Type;
+			auto node = nodes.Args() + i + 1;
+			args.Insert(tvs.Args() + i, node, prev);
+			prev = node;
+			argType = argType->Next;
+		}
+
+		auto node = function_->Node.Get();
+		for (uint32_t row = 1; row <= numRows; row++) {
+			if (lua_rawgeti(L, rowsIdx, row) != LUA_TTABLE) {
+				luaL_error(L, "Row %d passed to '%s' is not a table", row, function_->Signature->Name);
+			}
+
+			auto rowIdx = lua_gettop(L);
+			// Nil (wildcard) columns are allowed when deleting, so the row may appear shorter
+			auto numColumns = (uint32_t)lua_rawlen(L, rowIdx);
+			if (numColumns > funcArgs || (!deleteTuples && numColumns != funcArgs)) {
+				luaL_error(L, "Incorrect number of columns in row %d for '%s'; expected %d, got %d",
+					row, function_->Signature->Name, funcArgs, numColumns);
+			}
+
+			// Column values stay on the stack until the tuple is processed, as string values point into Lua strings
+			for (uint32_t i = 0; i < funcArgs; i++) {
+				lua_rawgeti(L, rowIdx, i + 1);
+				LuaToOsi(L, rowIdx + 1 + i, tvs.Args()[i], types[i], deleteTuples);
+			}
+
+			if (deleteTuples) {
+				node->DeleteTuple(&tuple);
+			} else {
+				node->InsertTuple(&tuple);
+			}
+
+			lua_settop(L, rowIdx - 1);
+		}
+
+		return numRows;
+	}
+
 	int OsiFunction::OsiQuery(lua_State * L)
 	{
 		auto outParams = function_->Signature->OutParamList.numOutParams();
@@ -729,6 +815,12 @@ namespace bg3se::esv::lua
 		lua_pushcfunction(L, &LuaDelete);
 		lua_setfield(L, -2, "Delete");
 
+		lua_pushcfunction(L, &LuaInsertMany);
+		lua_setfield(L, -2, "InsertMany");
+
+		lua_pushcfunction(L, &LuaDeleteMany);
+		lua_setfield(L, -2, "DeleteMany");
+
 		lua_pushcfunction(L, &LuaDeferredNotification);
 		lua_setfield(L, -2, "Defer");
 
@@ -813,6 +905,52 @@ namespace bg3se::esv::lua
 		return func->LuaDelete(L);
 	}
 
+	int OsiFunctionNameProxy::LuaInsertMany(lua_State * L)
+	{
+		return LuaModifyMany(L, false);
+	}
+
+	int OsiFunctionNameProxy::LuaDeleteMany(lua_State * L)
+	{
+		return LuaModifyMany(L, true);
+	}
+
+	int OsiFunctionNameProxy::LuaModifyMany(lua_State * L, bool deleteTuples)
+	{
+		auto self = OsiFunctionNameProxy::CheckUserData(L, 1);
+		if (!self->BeforeCall(L)) return 1;
+
+		luaL_checktype(L, 2, LUA_TTABLE);
+		// Arity is taken from the first row unless specified explicitly
+		uint32_t arity;
+		if (lua_isnoneornil(L, 3)) {
+			if (lua_rawlen(L, 2) == 0) {
+				push(L, 0);
+				return 1;
+			}
+
+			if (lua_rawgeti(L, 2, 1) != LUA_TTABLE) {
+				return luaL_error(L, "Row 1 passed to '%s' is not a table", self->name_.c_str());
+			}
+
+			arity = (uint32_t)lua_rawlen(L, -1);
+			lua_pop(L, 1);
+		} else {
+			arity = (uint32_t)luaL_checkinteger(L, 3);
+		}
+
+		auto func = self->TryGetFunction(arity);
+		if (func == nullptr) {
+			return luaL_error(L, "No database named '%s(%d)' exists", self->name_.c_str(), arity);
+		}
+
+		if (!func->IsDB()) {
+			return luaL_error(L, "Function '%s(%d)' is not a database", self->name_.c_str(), arity);
+		}
+
+		return func->LuaModifyMany(L, 2, deleteTuples);
+	}
+
 	int OsiFunctionNameProxy::LuaDeferredNotification(lua_State * L)
 	{
 		auto self = OsiFunctionNameProxy::CheckUserData(L, 1);
@@ -906,6 +1044,52 @@ namespace bg3se::esv::lua
 	}
 
 
+	void ServerState::Call(char const* mod, char const* func, OsiArgumentDesc const* args)
+	{
+		auto L = GetState();
+		LifetimeStackPin _(GetStack());
+		auto stackSize = lua_gettop(L);
+
+		try {
+			if (mod != nullptr) {
+				PushModFunction(L, mod, func); // stack: func
+			} else {
+				lua_getglobal(L, func); // stack: func
+			}
+
+			int numArgs{ 0 };
+			for (auto arg = args; arg != nullptr; arg = arg->NextParam) {
+				lua_checkstack(L, 1);
+				OsiToLua(L, arg->Value); // stack: func, arg0 ... argn
+				numArgs++;
+			}
+
+			auto status = CallWithTraceback(L, numArgs, 0);
+			if (status != LUA_OK) {
+				LuaError("Failed to call function '" << func << "': " << lua_tostring(L, -1));
+				// stack: errmsg
+				lua_pop(L, 1); // stack: -
+			}
+		} catch (Exception &) {
+			auto stackRemaining = lua_gettop(L) - stackSize;
+			if (stackRemaining > 0) {
+				if (mod != nullptr) {
+					LuaError("Call to mod function '" << mod << "'.'" << func << "' failed: " << lua_tostring(L, -1));
+				} else {
+					LuaError("Call to mod function '" << func << "' failed: " << lua_tostring(L, -1));
+				}
+				lua_pop(L, stackRemaining);
+			} else {
+				if (mod != nullptr) {
+					LuaError("Internal error during call to mod function '" << mod << "'.'" << func << "'");
+				} else {
+					LuaError("Internal error during call to mod function '" << func << "'");
+				}
+			}
+		}
+	}
+
+
 	bool ServerState::Query(char const* mod, char const* name, RegistryEntry * func,
 		std::vector<CustomFunctionParam> const & signature, OsiArgumentDesc & params)
 	{
@@ -1014,7 +1198,9 @@ namespace bg3se::esv::lua
 					if (lua_isnil(L, stackIndex)) {
 						numNulls++;
 					} else {
-						LuaToOsi(L, stackIndex, param->Value, signature[paramIndex].Type);
+						// Untyped (mod query) signatures take the type of the argument passed by Osiris
+						auto type = signature[paramIndex].Type != ValueType::None ? signature[paramIndex].Type : param->Value.TypeId;
+						LuaToOsi(L, stackIndex, param->Value, type);
 					}
 
 					numParams++;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bit>
+
 BEGIN_NS(lua)
 
 class EntityReplicationEventHooks
@@ -8,12 +10,17 @@ public:
 	EntityReplicationEventHooks(lua::State& state);
 	~EntityReplicationEventHooks();
 
-	void Subscribe(ecs::ReplicationTypeIndex type, EntityHandle entity, uint64_t flags, RegistryEntry&& hook);
+	uint32_t Subscribe(ecs::ReplicationTypeIndex type, EntityHandle entity, uint64_t flags, RegistryEntry&& hook);
 	bool Unsubscribe(uint32_t index);
 
 	void OnEntityReplication(ecs::EntityWorld& world);
 
 private:
+	// Hooks subscribed with all bits set also receive changes to flags past the first qword
+	static constexpr uint64_t AllFlags = 0xffffffffffffffffull;
+	// Bucket of global hooks that subscribed with AllFlags
+	static constexpr unsigned AnyFlagBucket = 64;
+
 	struct ReplicationHook
 	{
 		uint64_t InvalidationFlags;
@@ -22,12 +29,20 @@ private:
 		ecs::ReplicationTypeIndex Type;
 		EntityHandle Entity;
 		uint32_t Index;
+		// Position in each bucket the hook is in (in bit order), or in the entity hook list
+		Array<uint32_t> Positions;
+		// Serial of the last dispatch that called the hook; a hook in multiple buckets is only called once
+		uint64_t LastDispatch{ 0 };
 	};
 
 	struct ReplicationHooks
 	{
-		uint64_t InvalidationFlags;
-		Array<ReplicationHook*> GlobalHooks;
+		// Bits that have at least one global hook
+		uint64_t GlobalFlags{ 0 };
+		// Number of entity-specific hooks; the entity lookup is skipped during dispatch when zero
+		uint32_t EntityHookCount{ 0 };
+		// Global hooks bucketed by invalidation bit
+		std::array<Array<ReplicationHook*>, AnyFlagBucket + 1> GlobalHooks;
 		MultiHashMap<EntityHandle, Array<ReplicationHook*>> EntityHooks;
 	};
 
@@ -36,11 +51,18 @@ private:
 	Array<ReplicationHooks> hookedReplicationComponents_;
 	Array<ReplicationHook*> subscriptions_;
 	Array<uint32_t> freeSlots_;
+	uint64_t dispatchSerial_{ 0 };
 
 	void OnEntityReplication(ecs::EntityWorld& world, EntityHandle entity, BitSet<> const& flags, ecs::ReplicationTypeIndex type);
+	Array<ReplicationHook*>* GetBucket(ecs::ReplicationTypeIndex type, EntityHandle entity, unsigned bit);
+	void DispatchBucket(ecs::ReplicationTypeIndex type, EntityHandle entityBucket, unsigned bit,
+		EntityHandle entity, BitSet<> const& flags, bool anyFlag);
 	void CallHandler(EntityHandle entity, BitSet<> const& flags, ecs::ReplicationTypeIndex type, ReplicationHook const& hook);
 	uint32_t FindFreeSlot();
 	ReplicationHooks& AddComponentType(ecs::ReplicationTypeIndex type);
+	void AddToBucket(Array<ReplicationHook*>& bucket, ReplicationHook* hook, uint32_t slot);
+	void RemoveFromBucket(Array<ReplicationHook*>& bucket, uint32_t position, unsigned bit);
+	static uint32_t GetPositionSlot(ReplicationHook const& hook, unsigned bit);
 };
 
 END_SE()
@@ -32,7 +32,34 @@ EntityReplicationEventHooks::ReplicationHooks& EntityReplicationEventHooks::AddC
 	return hookedReplicationComponents_[index];
 }
 
-void EntityReplicationEventHooks::Subscribe(ecs::ReplicationTypeIndex type, EntityHandle entity, uint64_t flags, RegistryEntry&& hook)
+uint32_t EntityReplicationEventHooks::GetPositionSlot(ReplicationHook const& hook, unsigned bit)
+{
+	if (hook.Entity || hook.InvalidationFlags == AllFlags) {
+		return 0;
+	} else {
+		return (uint32_t)std::popcount(hook.InvalidationFlags & ((1ull << bit) - 1));
+	}
+}
+
+void EntityReplicationEventHooks::AddToBucket(Array<ReplicationHook*>& bucket, ReplicationHook* hook, uint32_t slot)
+{
+	hook->Positions[slot] = bucket.size();
+	bucket.push_back(hook);
+}
+
+void EntityReplicationEventHooks::RemoveFromBucket(Array<ReplicationHook*>& bucket, uint32_t position, unsigned bit)
+{
+	auto lastPosition = bucket.size() - 1;
+	if (position != lastPosition) {
+		auto moved = bucket[lastPosition];
+		bucket[position] = moved;
+		moved->Positions[GetPositionSlot(*moved, bit)] = position;
+	}
+
+	bucket.remove_last();
+}
+
+uint32_t EntityReplicationEventHooks::Subscribe(ecs::ReplicationTypeIndex type, EntityHandle entity, uint64_t flags, RegistryEntry&& hook)
 {
 	auto slot = FindFreeSlot();
 	auto& pool = AddComponentType(type);
@@ -43,20 +70,29 @@ void EntityReplicationEventHooks::Subscribe(ecs::ReplicationTypeIndex type, Enti
 	hookEntry->Entity = entity;
 	hookEntry->Index = slot;
 
-	pool.InvalidationFlags |= flags;
-	if (!entity) {
-		pool.GlobalHooks.Add(hookEntry);
-	} else {
+	if (entity) {
+		pool.EntityHookCount++;
+		hookEntry->Positions.resize(1);
 		auto entityHooks = pool.EntityHooks.Find(entity);
-		if (entityHooks) {
-			(*entityHooks)->push_back(hookEntry);
-		} else {
+		if (!entityHooks) {
 			entityHooks = pool.EntityHooks.Set(entity, {});
-			(*entityHooks)->push_back(hookEntry);
+		}
+
+		AddToBucket(**entityHooks, hookEntry, 0);
+	} else if (flags == AllFlags) {
+		hookEntry->Positions.resize(1);
+		AddToBucket(pool.GlobalHooks[AnyFlagBucket], hookEntry, 0);
+	} else {
+		pool.GlobalFlags |= flags;
+		hookEntry->Positions.resize((uint32_t)std::popcount(flags));
+		uint32_t posSlot{ 0 };
+		for (auto bits = flags; bits != 0; bits &= bits - 1) {
+			AddToBucket(pool.GlobalHooks[std::countr_zero(bits)], hookEntry, posSlot++);
 		}
 	}
 
 	subscriptions_[slot] = hookEntry;
+	return slot;
 }
 
 bool EntityReplicationEventHooks::Unsubscribe(uint32_t index)
@@ -67,28 +103,35 @@ bool EntityReplicationEventHooks::Unsubscribe(uint32_t index)
 
 	auto sub = subscriptions_[index];
 	auto& pool = hookedReplicationComponents_[(unsigned)sub->Type.Value()];
-	if (!sub->Entity) {
-		for (unsigned i = 0; i < pool.GlobalHooks.size(); i++) {
-			if (pool.GlobalHooks[i]->Index == index) {
-				pool.GlobalHooks.remove_at(i);
-				break;
+	if (sub->Entity) {
+		auto entityHooks = pool.EntityHooks.Find(sub->Entity);
+		if (entityHooks) {
+			RemoveFromBucket(**entityHooks, sub->Positions[0], AnyFlagBucket);
+			if ((*entityHooks)->empty()) {
+				// Move the list out first, as removing the last map entry doesn't destroy its value
+				Array<ReplicationHook*> released{ std::move(**entityHooks) };
+				pool.EntityHooks.remove(sub->Entity);
 			}
 		}
+
+		pool.EntityHookCount--;
+	} else if (sub->InvalidationFlags == AllFlags) {
+		RemoveFromBucket(pool.GlobalHooks[AnyFlagBucket], sub->Positions[0], AnyFlagBucket);
 	} else {
-		auto entityHooks = pool.EntityHooks.Find(sub->Entity);
-		if (entityHooks) {
-			for (unsigned i = 0; i < (*entityHooks)->size(); i++) {
-				if ((**entityHooks)[i]->Index == index) {
-					(*entityHooks)->remove_at(i);
-					break;
-				}
+		uint32_t posSlot{ 0 };
+		for (auto bits = sub->InvalidationFlags; bits != 0; bits &= bits - 1) {
+			auto bit = (unsigned)std::countr_zero(bits);
+			auto& bucket = pool.GlobalHooks[bit];
+			RemoveFromBucket(bucket, sub->Positions[posSlot++], bit);
+			if (bucket.empty()) {
+				pool.GlobalFlags &= ~(1ull << bit);
 			}
 		}
 	}
 
 	subscriptions_[index] = nullptr;
 	freeSlots_.push_back(index);
-	GameFree(sub);
+	GameDelete(sub);
 	return true;
 }
 
@@ -106,25 +149,70 @@ void EntityReplicationEventHooks::OnEntityReplication(ecs::EntityWorld& world)
 	}
 }
 
-void EntityReplicationEventHooks::OnEntityReplication(ecs::EntityWorld& world, EntityHandle entity, BitSet<> const& flags, ecs::ReplicationTypeIndex type)
+Array<EntityReplicationEventHooks::ReplicationHook*>* EntityReplicationEventHooks::GetBucket(ecs::ReplicationTypeIndex type, EntityHandle entity, unsigned bit)
 {
 	auto& hooks = hookedReplicationComponents_[type.Value()];
-	auto word1 = *flags.GetBuf();
-	if ((hooks.InvalidationFlags & word1) == 0) return;
+	if (entity) {
+		auto entityHooks = hooks.EntityHooks.Find(entity);
+		return entityHooks ? *entityHooks : nullptr;
+	} else {
+		return &hooks.GlobalHooks[bit];
+	}
+}
 
-	for (auto const& hook : hooks.GlobalHooks) {
-		if ((hook->InvalidationFlags & word1) != 0) {
+void EntityReplicationEventHooks::DispatchBucket(ecs::ReplicationTypeIndex type, EntityHandle entityBucket, unsigned bit,
+	EntityHandle entity, BitSet<> const& flags, bool anyFlag)
+{
+	// Handlers may subscribe or unsubscribe during the call, so the bucket is looked up again after each call.
+	// Walking backwards works with swap-remove, as it only moves already visited hooks into the unvisited range;
+	// the dispatch serial filters those out.
+	auto word1 = *flags.GetBuf();
+	auto bucket = GetBucket(type, entityBucket, bit);
+	for (auto i = bucket ? bucket->size() : 0; i > 0; i--) {
+		if (i > bucket->size()) continue;
+
+		auto hook = (*bucket)[i - 1];
+		auto matches = (hook->InvalidationFlags == AllFlags) ? anyFlag : ((hook->InvalidationFlags & word1) != 0);
+		if (matches && hook->LastDispatch != dispatchSerial_) {
+			hook->LastDispatch = dispatchSerial_;
 			CallHandler(entity, flags, type, *hook);
+			bucket = GetBucket(type, entityBucket, bit);
+			if (!bucket) break;
 		}
 	}
+}
 
-	auto entityHooks = hooks.EntityHooks.Find(entity);
-	if (entityHooks) {
-		for (auto const& hook : **entityHooks) {
-			if ((hook->InvalidationFlags & word1) != 0) {
-				CallHandler(entity, flags, type, *hook);
-			}
-		}
+bool HasAnyReplicationFlag(BitSet<> const& flags)
+{
+	auto buf = flags.GetBuf();
+	auto numQwords = std::max(flags.NumQwords(), 1u);
+	for (uint32_t i = 0; i < numQwords; i++) {
+		if (buf[i] != 0) return true;
+	}
+
+	return false;
+}
+
+void EntityReplicationEventHooks::OnEntityReplication(ecs::EntityWorld& world, EntityHandle entity, BitSet<> const& flags, ecs::ReplicationTypeIndex type)
+{
+	auto& hooks = hookedReplicationComponents_[type.Value()];
+	auto word1 = *flags.GetBuf();
+	auto anyFlag = word1 != 0 || HasAnyReplicationFlag(flags);
+	if (!anyFlag) return;
+
+	dispatchSerial_++;
+	auto globalBits = hooks.GlobalFlags & word1;
+	auto hasEntityHooks = hooks.EntityHookCount > 0;
+
+	DispatchBucket(type, EntityHandle{}, AnyFlagBucket, entity, flags, anyFlag);
+
+	for (auto bits = globalBits; bits != 0; bits &= bits - 1) {
+		DispatchBucket(type, EntityHandle{}, (unsigned)std::countr_zero(bits), entity, flags, anyFlag);
+	}
+
+	// Entity hook lists are short, so they're matched directly instead of being bucketed
+	if (hasEntityHooks) {
+		DispatchBucket(type, entity, AnyFlagBucket, entity, flags, anyFlag);
 	}
 }
 
@@ -29,6 +29,12 @@ namespace bg3se::esv::lua
 	LifetimeHandle GetServerLifetime();
 	LifetimePool& GetServerLifetimePool();
 
+	namespace tmpl
+	{
+		// Flushes the template ID -> template manager mapping used by Ext.Template.GetTemplate()
+		void InvalidateTemplateCache();
+	}
+
 	struct GameStateChangedEvent : public EventBase
 	{
 		esv::GameState FromState;
@@ -268,49 +274,8 @@ namespace bg3se::esv::lua
 		ecs::EntitySystemHelpersBase* GetEntitySystemHelpers() override;
 		EntityReplicationEventHooks* GetReplicationEventHooks() override;
 
-		template <class TArg>
-		void Call(char const* mod, char const* func, std::vector<TArg> const & args)
-		{
-			auto L = GetState();
-			LifetimeStackPin _(GetStack());
-			lua_checkstack(L, (int)args.size() + 1);
-			auto stackSize = lua_gettop(L);
-
-			try {
-				if (mod != nullptr) {
-					PushModFunction(L, mod, func); // stack: func
-				} else {
-					lua_getglobal(L, func); // stack: func
-				}
-
-				for (auto & arg : args) {
-					OsiToLua(L, arg); // stack: func, arg0 ... argn
-				}
-
-				auto status = CallWithTraceback(L, (int)args.size(), 0);
-				if (status != LUA_OK) {
-					LuaError("Failed to call function '" << func << "': " << lua_tostring(L, -1));
-					// stack: errmsg
-					lua_pop(L, 1); // stack: -
-				}
-			} catch (Exception &) {
-				auto stackRemaining = lua_gettop(L) - stackSize;
-				if (stackRemaining > 0) {
-					if (mod != nullptr) {
-						LuaError("Call to mod function '" << mod << "'.'" << func << "' failed: " << lua_tostring(L, -1));
-					} else {
-						LuaError("Call to mod function '" << func << "' failed: " << lua_tostring(L, -1));
-					}
-					lua_pop(L, stackRemaining);
-				} else {
-					if (mod != nullptr) {
-						LuaError("Internal error during call to mod function '" << mod << "'.'" << func << "'");
-					} else {
-						LuaError("Internal error during call to mod function '" << func << "'");
-					}
-				}
-			}
-		}
+		// Calls Mods[mod][func] (or the global func if mod is null) with each value of the argument list
+		void Call(char const* mod, char const* func, OsiArgumentDesc const* args);
 
 		std::optional<STDString> GetModPersistentVars(STDString const& modTable);
 		void RestoreModPersistentVars(STDString const& modTable, STDString const& vars);
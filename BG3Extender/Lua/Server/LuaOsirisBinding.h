@@ -78,6 +78,8 @@ public:
 	int LuaCall(lua_State * L);
 	int LuaGet(lua_State * L);
 	int LuaDelete(lua_State * L);
+	// Inserts or deletes each row of the table at the specified stack index
+	int LuaModifyMany(lua_State * L, int rowsIdx, bool deleteTuples);
 	int LuaDeferredNotification(lua_State * L);
 
 private:
@@ -88,6 +90,7 @@ private:
 	void OsiCall(lua_State * L);
 	void OsiDeferredNotification(lua_State * L);
 	void OsiInsert(lua_State * L, bool deleteTuple);
+	uint32_t OsiInsertMany(lua_State * L, int rowsIdx, bool deleteTuples);
 	int OsiQuery(lua_State * L);
 	int OsiUserQuery(lua_State * L);
 
@@ -118,6 +121,9 @@ private:
 
 	static int LuaGet(lua_State * L);
 	static int LuaDelete(lua_State * L);
+	static int LuaInsertMany(lua_State * L);
+	static int LuaDeleteMany(lua_State * L);
+	static int LuaModifyMany(lua_State * L, bool deleteTuples);
 	static int LuaDeferredNotification(lua_State * L);
 	bool BeforeCall(lua_State * L);
 	OsiFunction * TryGetFunction(uint32_t arity);
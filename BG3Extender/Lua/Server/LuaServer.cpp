@@ -155,6 +155,8 @@ namespace bg3se::esv::lua
 		StackCheck _(L, 0);
 
 		library_.Register(L);
+		// Templates may have been reloaded along with the modules before a reset
+		tmpl::InvalidateTemplateCache();
 
 		gExtender->GetServer().GetExtensionState().LuaLoadBuiltinFile("ServerStartup.lua");
 		/*
@@ -222,6 +224,7 @@ namespace bg3se::esv::lua
 	void ServerState::OnGameSessionLoading()
 	{
 		osiris_.GetIdentityAdapterMap().UpdateAdapters();
+		tmpl::InvalidateTemplateCache();
 
 		State::OnGameSessionLoading();
 	}
@@ -15,39 +15,52 @@ namespace bg3se::lua
 	}
 	
 
-	void LuaMakeStatusProxy(lua_State* L, esv::Status* status, LifetimeHandle const& lifetime)
+	using StatusPushProc = void (lua_State* L, esv::Status* status, LifetimeHandle const& lifetime);
+
+	template <class T>
+	void PushStatus(lua_State* L, esv::Status* status, LifetimeHandle const& lifetime)
 	{
-#define S(ty, cls) case StatusType::ty: MakeDirectObjectRef(L, static_cast<cls*>(status), lifetime); break;
-
-		switch (status->GetStatusId()) {
-			S(DYING, esv::StatusDying)
-			S(HEAL, esv::StatusHeal)
-			S(KNOCKED_DOWN, esv::StatusKnockedDown)
-			S(TELEPORT_FALLING, esv::StatusTeleportFalling)
-			S(BOOST, esv::StatusBoost)
-			S(REACTION, esv::StatusReaction)
-			S(STORY_FROZEN, esv::StatusStoryFrozen)
-			S(SNEAKING, esv::StatusSneaking)
-			S(UNLOCK, esv::StatusUnlock)
-			S(FEAR, esv::StatusFear)
-			S(SMELLY, esv::StatusSmelly)
-			S(INVISIBLE, esv::StatusInvisible)
-			S(ROTATE, esv::StatusRotate)
-			S(MATERIAL, esv::StatusMaterial)
-			S(CLIMBING, esv::StatusClimbing)
-			S(INCAPACITATED, esv::StatusIncapacitated)
-			S(INSURFACE, esv::StatusInSurface)
-			S(POLYMORPHED, esv::StatusPolymorphed)
-			S(EFFECT, esv::StatusEffect)
-			S(DEACTIVATED, esv::StatusDeactivated)
-			S(DOWNED, esv::StatusDowned)
-
-		default:
-			MakeDirectObjectRef(L, status, lifetime);
-			break;
-		}
+		MakeDirectObjectRef(L, static_cast<T*>(status), lifetime);
+	}
+
+	struct StatusTypeInfo
+	{
+		StatusPushProc* Push{ &PushStatus<esv::Status> };
+	};
+
+	constexpr uint32_t MaxStatusType = std::max({
+#define S(ty, cls) (uint32_t)StatusType::ty,
+#include <GameDefinitions/AllStatusTypes.inl>
+#undef S
+	});
+
+	// Status class info indexed by StatusType, so pushing a status doesn't need to branch on its type
+	std::array<StatusTypeInfo, MaxStatusType + 1> BuildStatusTypeRegistry()
+	{
+		std::array<StatusTypeInfo, MaxStatusType + 1> types;
 
+#define S(ty, cls) types[(uint32_t)StatusType::ty] = StatusTypeInfo{ &PushStatus<cls> };
+#include <GameDefinitions/AllStatusTypes.inl>
 #undef S
+
+		return types;
+	}
+
+	static std::array<StatusTypeInfo, MaxStatusType + 1> const gStatusTypes = BuildStatusTypeRegistry();
+
+	StatusTypeInfo const& GetStatusTypeInfo(StatusType type)
+	{
+		static StatusTypeInfo const baseStatus;
+		if ((uint32_t)type <= MaxStatusType) {
+			return gStatusTypes[(uint32_t)type];
+		} else {
+			return baseStatus;
+		}
+	}
+
+	void LuaMakeStatusProxy(lua_State* L, esv::Status* status, LifetimeHandle const& lifetime)
+	{
+		GetStatusTypeInfo(status->GetStatusId()).Push(L, status, lifetime);
 	}
 }
 
@@ -0,0 +1,209 @@
+#include <stdafx.h>
+#include <Lua/Shared/LuaAllocator.h>
+
+BEGIN_NS(lua)
+
+namespace
+{
+	constexpr std::size_t Granularity = 16;
+	constexpr std::array<uint32_t, 13> SizeClasses{ 16, 32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512 };
+
+	// Maps (size + Granularity - 1) / Granularity to the smallest size class that fits the block
+	constexpr auto SizeClassLookup = []() {
+		std::array<uint8_t, SizeClasses.back() / Granularity + 1> lookup{};
+		uint8_t sizeClass = 0;
+		for (uint32_t i = 0; i < lookup.size(); i++) {
+			while (SizeClasses[sizeClass] < i * Granularity) {
+				sizeClass++;
+			}
+
+			lookup[i] = sizeClass;
+		}
+
+		return lookup;
+	}();
+}
+
+LuaAllocator::~LuaAllocator()
+{
+	for (auto slab : slabs_) {
+		GameFree(slab);
+	}
+}
+
+void* LuaAllocator::LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+	return reinterpret_cast<LuaAllocator*>(ud)->Realloc(ptr, osize, nsize);
+}
+
+void* LuaAllocator::GameAllocatorRealloc(void* ptr, size_t osize, size_t nsize)
+{
+	if (nsize == 0) {
+		GameFree(ptr);
+		return nullptr;
+	} else {
+		auto newBuf = GameAllocRaw(nsize);
+		if (ptr != nullptr) {
+			memcpy(newBuf, ptr, std::min(nsize, osize));
+			GameFree(ptr);
+		}
+
+		return newBuf;
+	}
+}
+
+uint32_t LuaAllocator::GetSizeClass(std::size_t size)
+{
+	static_assert(SizeClasses.size() == NumSizeClasses && SizeClasses.back() == MaxSmallSize);
+	return SizeClassLookup[(size + Granularity - 1) / Granularity];
+}
+
+void* LuaAllocator::AllocSmall(uint32_t sizeClass)
+{
+	auto& cls = classes_[sizeClass];
+	if (cls.FreeList != nullptr) {
+		auto block = cls.FreeList;
+		cls.FreeList = block->Next;
+		return block;
+	}
+
+	auto blockSize = SizeClasses[sizeClass];
+	if (cls.SlabPos + blockSize > cls.SlabEnd) {
+		auto slab = reinterpret_cast<uint8_t*>(GameAllocRaw(SlabSize));
+		slabs_.push_back(slab);
+		stats_.SlabBytes += SlabSize;
+		cls.SlabPos = slab;
+		cls.SlabEnd = slab + SlabSize - (SlabSize % blockSize);
+	}
+
+	auto block = cls.SlabPos;
+	cls.SlabPos += blockSize;
+	return block;
+}
+
+void LuaAllocator::FreeSmall(void* ptr, uint32_t sizeClass)
+{
+	auto block = reinterpret_cast<FreeBlock*>(ptr);
+	block->Next = classes_[sizeClass].FreeList;
+	classes_[sizeClass].FreeList = block;
+}
+
+void* LuaAllocator::Realloc(void* ptr, size_t osize, size_t nsize)
+{
+	// When ptr is null, osize holds the type of the object being allocated, not a size
+	if (ptr == nullptr) {
+		osize = 0;
+	}
+
+	void* newPtr;
+	if (nsize == 0) {
+		// Lua frees empty (null) arrays too
+		if (ptr == nullptr) {
+			return nullptr;
+		}
+
+		if (osize <= MaxSmallSize) {
+			FreeSmall(ptr, GetSizeClass(osize));
+		} else {
+			GameFree(ptr);
+		}
+
+		newPtr = nullptr;
+		stats_.NumFrees++;
+	} else if (ptr == nullptr) {
+		if (nsize <= MaxSmallSize) {
+			newPtr = AllocSmall(GetSizeClass(nsize));
+		} else {
+			newPtr = GameAllocRaw(nsize);
+		}
+
+		stats_.NumAllocations++;
+		stats_.AllocatedBytes += nsize;
+	} else {
+		stats_.NumReallocations++;
+		if (nsize > osize) {
+			stats_.AllocatedBytes += nsize - osize;
+		}
+		if (osize <= MaxSmallSize && nsize <= MaxSmallSize && GetSizeClass(osize) == GetSizeClass(nsize)) {
+			// Block is already large enough
+			newPtr = ptr;
+			stats_.NumInPlaceReallocations++;
+		} else {
+			newPtr = (nsize <= MaxSmallSize) ? AllocSmall(GetSizeClass(nsize)) : GameAllocRaw(nsize);
+			memcpy(newPtr, ptr, std::min(osize, nsize));
+			if (osize <= MaxSmallSize) {
+				FreeSmall(ptr, GetSizeClass(osize));
+			} else {
+				GameFree(ptr);
+			}
+		}
+	}
+
+	stats_.LiveBytes += nsize;
+	stats_.LiveBytes -= osize;
+	stats_.PeakBytes = std::max(stats_.PeakBytes, stats_.LiveBytes);
+
+	if (tracing_) {
+		Record(ptr, newPtr, osize, nsize);
+	}
+
+	return newPtr;
+}
+
+double LuaAllocator::SampleAllocationRate()
+{
+	auto now = std::chrono::steady_clock::now();
+	auto elapsed = std::chrono::duration<double>(now - lastRateSample_).count();
+	auto allocations = stats_.NumAllocations - lastRateAllocations_;
+	lastRateSample_ = now;
+	lastRateAllocations_ = stats_.NumAllocations;
+	return elapsed > 0.0 ? allocations / elapsed : 0.0;
+}
+
+void LuaAllocator::StartTrace(uint32_t maxEntries)
+{
+	tracing_ = true;
+	maxTraceEntries_ = maxEntries;
+	trace_.clear();
+	trace_.reserve(maxEntries);
+	traceBlocks_.clear();
+	nextTraceBlock_ = 0;
+}
+
+std::vector<LuaAllocator::TraceEntry> LuaAllocator::StopTrace()
+{
+	tracing_ = false;
+	traceBlocks_.clear();
+	return std::move(trace_);
+}
+
+void LuaAllocator::Record(void* ptr, void* newPtr, size_t osize, size_t nsize)
+{
+	// Blocks allocated before the trace started are recorded as new allocations,
+	// so that the trace can be replayed on its own
+	uint32_t block;
+	auto it = ptr ? traceBlocks_.find(ptr) : traceBlocks_.end();
+	if (it != traceBlocks_.end()) {
+		block = it->second;
+		traceBlocks_.erase(it);
+	} else {
+		if (nsize == 0) {
+			return;
+		}
+
+		block = nextTraceBlock_++;
+		osize = 0;
+	}
+
+	if (newPtr != nullptr) {
+		traceBlocks_.insert(std::make_pair(newPtr, block));
+	}
+
+	trace_.push_back(TraceEntry{ block, (uint32_t)osize, (uint32_t)nsize });
+	if (trace_.size() >= maxTraceEntries_) {
+		tracing_ = false;
+		traceBlocks_.clear();
+	}
+}
+
+END_NS()
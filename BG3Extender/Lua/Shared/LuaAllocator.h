@@ -0,0 +1,98 @@
+#pragma once
+
+#include <CoreLib/Base/Base.h>
+
+#include <array>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NS(lua)
+
+// Memory allocator for Lua states.
+// Small blocks are carved from per-state slabs in fixed size classes and recycled through per-class
+// free lists; reallocations that stay within the same size class are done in place. Blocks larger
+// than the largest size class are passed through to the game allocator.
+// A Lua state is only ever used by one thread at a time, so the allocator does no locking.
+// Slab memory is kept until the allocator is destroyed (i.e. the Lua state is closed).
+class LuaAllocator : Noncopyable<LuaAllocator>
+{
+public:
+	struct Statistics
+	{
+		uint64_t LiveBytes{ 0 };
+		uint64_t PeakBytes{ 0 };
+		uint64_t SlabBytes{ 0 };
+		// Total number of bytes allocated (including growth by reallocations), never decreases
+		uint64_t AllocatedBytes{ 0 };
+		uint64_t NumAllocations{ 0 };
+		uint64_t NumFrees{ 0 };
+		uint64_t NumReallocations{ 0 };
+		uint64_t NumInPlaceReallocations{ 0 };
+	};
+
+	// Recorded allocator call; blocks are identified by the order in which they were allocated
+	struct TraceEntry
+	{
+		uint32_t Block;
+		uint32_t OldSize;
+		uint32_t NewSize;
+	};
+
+	~LuaAllocator();
+
+	// lua_Alloc callback; the userdata must point to the allocator
+	static void* LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize);
+	// Reference implementation without size classes; allocates a new block for every reallocation
+	static void* GameAllocatorRealloc(void* ptr, size_t osize, size_t nsize);
+
+	void* Realloc(void* ptr, size_t osize, size_t nsize);
+
+	inline Statistics const& GetStatistics() const
+	{
+		return stats_;
+	}
+
+	// Returns the number of allocations per second since the previous call
+	double SampleAllocationRate();
+
+	void StartTrace(uint32_t maxEntries);
+	std::vector<TraceEntry> StopTrace();
+
+private:
+	static constexpr std::size_t SlabSize = 0x10000;
+	static constexpr std::size_t NumSizeClasses = 13;
+	static constexpr std::size_t MaxSmallSize = 512;
+
+	struct FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+	struct SizeClass
+	{
+		FreeBlock* FreeList{ nullptr };
+		uint8_t* SlabPos{ nullptr };
+		uint8_t* SlabEnd{ nullptr };
+	};
+
+	std::array<SizeClass, NumSizeClasses> classes_;
+	std::vector<void*> slabs_;
+	Statistics stats_;
+
+	std::chrono::steady_clock::time_point lastRateSample_{ std::chrono::steady_clock::now() };
+	uint64_t lastRateAllocations_{ 0 };
+
+	bool tracing_{ false };
+	uint32_t maxTraceEntries_{ 0 };
+	std::vector<TraceEntry> trace_;
+	std::unordered_map<void*, uint32_t> traceBlocks_;
+	uint32_t nextTraceBlock_{ 0 };
+
+	static uint32_t GetSizeClass(std::size_t size);
+	void* AllocSmall(uint32_t sizeClass);
+	void FreeSmall(void* ptr, uint32_t sizeClass);
+	void Record(void* ptr, void* newPtr, size_t osize, size_t nsize);
+};
+
+END_NS()
@@ -55,4 +55,21 @@ std::optional<STDString> LuaBundle::GetResource(STDString const& path) const
 	}
 }
 
+std::optional<STDString> LuaBundle::GetCompiledChunk(STDString const& path, StringView source) const
+{
+	std::lock_guard _(compiledChunksMutex_);
+	auto it = compiledChunks_.find(path);
+	if (it != compiledChunks_.end() && it->second.Source == source) {
+		return it->second.Bytecode;
+	} else {
+		return {};
+	}
+}
+
+void LuaBundle::SetCompiledChunk(STDString const& path, StringView source, STDString&& bytecode)
+{
+	std::lock_guard _(compiledChunksMutex_);
+	compiledChunks_[path] = CompiledChunk{ STDString(source), std::move(bytecode) };
+}
+
 END_NS()
@@ -2,6 +2,7 @@
 
 #include <GameDefinitions/Base/Base.h>
 #include <unordered_map>
+#include <mutex>
 #include <span>
 #include <vector>
 
@@ -16,9 +17,25 @@ public:
 
 	std::optional<STDString> GetResource(STDString const& path) const;
 
+	// Compiled chunks of builtin scripts are shared between Lua states, so only the first
+	// state that loads a script has to parse it. Chunks are only reused if the source matches
+	// the one they were compiled from, so scripts loaded from the resource override path are
+	// recompiled when they change.
+	std::optional<STDString> GetCompiledChunk(STDString const& path, StringView source) const;
+	void SetCompiledChunk(STDString const& path, StringView source, STDString&& bytecode);
+
 private:
+	struct CompiledChunk
+	{
+		STDString Source;
+		STDString Bytecode;
+	};
+
 	std::unordered_map<STDString, STDString> resources_;
 	std::wstring resourcePath_;
+	// Server and client states are created on different threads
+	mutable std::mutex compiledChunksMutex_;
+	std::unordered_map<STDString, CompiledChunk> compiledChunks_;
 
 	struct ResourceHeader
 	{
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Lua/LuaHelpers.h>
+#include <lua/LuaBinding.h>
+
+#include <vector>
+
+BEGIN_NS(lua)
+
+// Flat open-addressing hash table of entity handles.
+// Handles are stored densely in insertion order (removal swaps the last handle into the freed slot),
+// and the bucket array maps each handle to its dense index. This keeps iteration a linear walk
+// and lets the map userdata keep its values in a parallel Lua array.
+class EntityHandleTable
+{
+public:
+	inline uint32_t Size() const
+	{
+		return (uint32_t)handles_.size();
+	}
+
+	inline EntityHandle operator [] (uint32_t index) const
+	{
+		return handles_[index];
+	}
+
+	std::optional<uint32_t> Find(EntityHandle handle) const;
+	// Returns the dense index of the handle and whether it was newly inserted
+	std::pair<uint32_t, bool> Insert(EntityHandle handle);
+	// Removes the handle and returns the dense index it occupied; the last handle
+	// (if any) is moved into that index
+	std::optional<uint32_t> Remove(EntityHandle handle);
+	void Clear();
+
+private:
+	static constexpr uint32_t EmptyBucket = 0xffffffffu;
+	static constexpr uint32_t MinBuckets = 16;
+
+	std::vector<EntityHandle> handles_;
+	std::vector<uint32_t> buckets_;
+
+	inline std::size_t BucketMask() const
+	{
+		return buckets_.size() - 1;
+	}
+
+	std::size_t Hash(EntityHandle handle) const;
+	std::size_t FindBucket(EntityHandle handle) const;
+	void EraseBucket(std::size_t bucket);
+	void Rehash(std::size_t numBuckets);
+};
+
+// Set of entity handles that can be used from Lua without converting handles to table keys.
+class EntityHandleSet : public Userdata<EntityHandleSet>, public Lengthable, public Iterable
+{
+public:
+	static char const* const MetatableName;
+
+	static void PopulateMetatable(lua_State* L);
+	static EntityHandleSet* Make(lua_State* L);
+
+	int Length(lua_State* L);
+	int Next(lua_State* L);
+
+	inline EntityHandleTable& Handles()
+	{
+		return handles_;
+	}
+
+private:
+	EntityHandleTable handles_;
+
+	static int Contains(lua_State* L);
+	static int Add(lua_State* L);
+	static int Remove(lua_State* L);
+	static int Clear(lua_State* L);
+	static int Union(lua_State* L);
+	static int Intersect(lua_State* L);
+	static int ToTable(lua_State* L);
+};
+
+// Entity handle -> Lua value map.
+// Values are kept in the user value table of the userdata, at the dense index of their handle.
+class EntityHandleMap : public Userdata<EntityHandleMap>, public Lengthable, public Iterable
+{
+public:
+	static char const* const MetatableName;
+
+	static void PopulateMetatable(lua_State* L);
+	static EntityHandleMap* Make(lua_State* L);
+
+	int Length(lua_State* L);
+	int Next(lua_State* L);
+
+	inline EntityHandleTable& Handles()
+	{
+		return handles_;
+	}
+
+private:
+	EntityHandleTable handles_;
+
+	static int Contains(lua_State* L);
+	static int Get(lua_State* L);
+	static int Set(lua_State* L);
+	static int Remove(lua_State* L);
+	static int Clear(lua_State* L);
+	static int Keys(lua_State* L);
+
+	void RemoveValue(lua_State* L, int valuesIdx, uint32_t index);
+};
+
+END_NS()
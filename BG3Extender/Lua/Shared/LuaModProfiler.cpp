@@ -0,0 +1,187 @@
+#include <stdafx.h>
+#include <Lua/Shared/LuaModProfiler.h>
+#include <intrin.h>
+
+BEGIN_NS(lua)
+
+namespace
+{
+	// Measures the timestamp counter frequency against the performance counter once per process
+	double GetTicksPerMs()
+	{
+		static double ticksPerMs = []() {
+			LARGE_INTEGER freq, start, now;
+			QueryPerformanceFrequency(&freq);
+			QueryPerformanceCounter(&start);
+			auto startTsc = __rdtsc();
+			auto minCounts = freq.QuadPart / 500;
+			do {
+				QueryPerformanceCounter(&now);
+			} while (now.QuadPart - start.QuadPart < minCounts);
+
+			auto elapsedMs = (now.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+			return (__rdtsc() - startTsc) / elapsedMs;
+		}();
+
+		return ticksPerMs;
+	}
+}
+
+ModProfiler::ModProfiler(LuaAllocator const& allocator)
+	: allocator_(allocator)
+{}
+
+uint32_t ModProfiler::GetOwner(lua_State* L, int index)
+{
+	lua_Debug ar;
+	lua_pushvalue(L, index);
+	lua_getinfo(L, ">S", &ar);
+	return GetOwner(ar.source != nullptr ? StringView(ar.source) : StringView());
+}
+
+uint32_t ModProfiler::GetOwner(StringView chunkName)
+{
+	STDString name;
+	if (chunkName.starts_with("builtin://")) {
+		name = "builtin";
+	} else if (chunkName.starts_with("=")) {
+		name = chunkName.substr(1);
+	} else {
+		name = chunkName.substr(0, chunkName.find('/'));
+	}
+
+	auto it = owners_.find(name);
+	if (it != owners_.end()) {
+		return it->second;
+	}
+
+	auto owner = (uint32_t)mods_.size();
+	mods_.push_back(ModStats{ name });
+	quotaStates_.push_back(QuotaState{});
+	owners_.insert(std::make_pair(name, owner));
+	ApplyQuota(owner);
+	return owner;
+}
+
+void ModProfiler::Enter(uint32_t owner)
+{
+	auto now = __rdtsc();
+	Charge(now);
+	ownerStack_.push_back(current_);
+	current_ = (owner < mods_.size()) ? owner : NoOwner;
+	if (current_ != NoOwner) {
+		mods_[current_].Calls++;
+	}
+}
+
+bool ModProfiler::Exit()
+{
+	auto now = __rdtsc();
+	auto owner = current_;
+	Charge(now);
+	current_ = ownerStack_.back();
+	ownerStack_.pop_back();
+	return owner != NoOwner && quotaStates_[owner].Active && CheckQuota(owner, now);
+}
+
+void ModProfiler::Charge(uint64_t now)
+{
+	auto const& alloc = allocator_.GetStatistics();
+	if (current_ != NoOwner) {
+		auto ticks = now - lastSwitch_;
+		auto& mod = mods_[current_];
+		mod.Ticks += ticks;
+		mod.AllocatedBytes += alloc.AllocatedBytes - lastAllocatedBytes_;
+		mod.Allocations += alloc.NumAllocations - lastAllocations_;
+
+		auto& quota = quotaStates_[current_];
+		if (quota.Active) {
+			auto bucket = now / quota.BucketTicks;
+			if (bucket != quota.Bucket) {
+				// Clear buckets that fell out of the window since the last charge
+				auto expired = std::min<uint64_t>(bucket - quota.Bucket, WindowBuckets);
+				for (uint64_t i = 1; i <= expired; i++) {
+					quota.Buckets[(quota.Bucket + i) % WindowBuckets] = 0;
+				}
+				quota.Bucket = bucket;
+			}
+
+			quota.Buckets[bucket % WindowBuckets] += ticks;
+		}
+	}
+
+	lastSwitch_ = now;
+	lastAllocatedBytes_ = alloc.AllocatedBytes;
+	lastAllocations_ = alloc.NumAllocations;
+}
+
+bool ModProfiler::CheckQuota(uint32_t owner, uint64_t now)
+{
+	auto& quota = quotaStates_[owner];
+	uint64_t windowTicks{ 0 };
+	for (auto ticks : quota.Buckets) {
+		windowTicks += ticks;
+	}
+
+	if (windowTicks <= quota.BudgetTicks) {
+		return false;
+	}
+
+	auto& mod = mods_[owner];
+	mod.QuotaExceeded++;
+	if (now - quota.LastWarning >= quota.WindowTicks) {
+		quota.LastWarning = now;
+		WARN("Lua handlers of '%s' used %.2f ms in the last %.0f ms, exceeding their budget of %.2f ms%s",
+			mod.Name.c_str(), TicksToMs(windowTicks), TicksToMs(quota.WindowTicks), TicksToMs(quota.BudgetTicks),
+			quota.Disable ? "; disabling handler" : "");
+	}
+
+	return quota.Disable;
+}
+
+void ModProfiler::ApplyQuota(uint32_t owner)
+{
+	auto it = quotas_.find(mods_[owner].Name);
+	auto quota = (it != quotas_.end()) ? std::optional<Quota>(it->second) : defaultQuota_;
+
+	auto& state = quotaStates_[owner];
+	state = QuotaState{};
+	if (quota && quota->BudgetMs > 0.0 && quota->WindowMs > 0.0) {
+		auto ticksPerMs = GetTicksPerMs();
+		state.Active = true;
+		state.Disable = quota->Disable;
+		state.BudgetTicks = (uint64_t)(quota->BudgetMs * ticksPerMs);
+		state.WindowTicks = (uint64_t)(quota->WindowMs * ticksPerMs);
+		state.BucketTicks = std::max<uint64_t>(state.WindowTicks / WindowBuckets, 1);
+		state.Bucket = __rdtsc() / state.BucketTicks;
+	}
+}
+
+void ModProfiler::SetQuota(STDString const& mod, std::optional<Quota> const& quota)
+{
+	if (mod.empty()) {
+		defaultQuota_ = quota;
+	} else if (quota) {
+		quotas_[mod] = *quota;
+	} else {
+		quotas_.erase(mod);
+	}
+
+	for (uint32_t i = 0; i < mods_.size(); i++) {
+		ApplyQuota(i);
+	}
+}
+
+void ModProfiler::ResetStatistics()
+{
+	for (auto& mod : mods_) {
+		mod = ModStats{ mod.Name };
+	}
+}
+
+double ModProfiler::TicksToMs(uint64_t ticks) const
+{
+	return ticks / GetTicksPerMs();
+}
+
+END_NS()
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Lua/LuaHelpers.h>
+#include <Lua/Shared/LuaAllocator.h>
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NS(lua)
+
+// Per-mod CPU time and allocation accounting for Lua handlers and script chunks.
+// Work is attributed to the mod whose chunk defined the called function (i.e. the part of the chunk
+// name before the first '/'). Time is measured with the timestamp counter on handler entry and exit;
+// nested calls are charged to the innermost handler only, so the numbers are exclusive ("self") time.
+// Optional soft quotas limit the time a mod may spend within a sliding window.
+class ModProfiler : Noncopyable<ModProfiler>
+{
+public:
+	static constexpr uint32_t NoOwner = 0xffffffffu;
+
+	struct Quota
+	{
+		double BudgetMs{ 0.0 };
+		double WindowMs{ 0.0 };
+		// Disable handlers of the mod while it is over budget instead of just logging
+		bool Disable{ false };
+	};
+
+	struct ModStats
+	{
+		STDString Name;
+		uint64_t Calls{ 0 };
+		uint64_t Ticks{ 0 };
+		uint64_t AllocatedBytes{ 0 };
+		uint64_t Allocations{ 0 };
+		uint32_t QuotaExceeded{ 0 };
+	};
+
+	// Charges the work done during the lifetime of the scope to the specified owner
+	class Scope : Noncopyable<Scope>
+	{
+	public:
+		inline Scope(ModProfiler& profiler, uint32_t owner)
+			: profiler_(profiler)
+		{
+			profiler_.Enter(owner);
+		}
+
+		inline ~Scope()
+		{
+			if (!exited_) {
+				profiler_.Exit();
+			}
+		}
+
+		// Ends the scope early; returns true if the owner exceeded its quota
+		inline bool Exit()
+		{
+			exited_ = true;
+			return profiler_.Exit();
+		}
+
+	private:
+		ModProfiler& profiler_;
+		bool exited_{ false };
+	};
+
+	ModProfiler(LuaAllocator const& allocator);
+
+	// Returns the owner ID of the function at the specified stack index
+	uint32_t GetOwner(lua_State* L, int index);
+	uint32_t GetOwner(StringView chunkName);
+
+	void Enter(uint32_t owner);
+	// Returns true if the owner exceeded its quota and the handler should be disabled
+	bool Exit();
+
+	// Sets the quota of a mod; an empty mod name sets the default quota of all mods without their own quota
+	void SetQuota(STDString const& mod, std::optional<Quota> const& quota);
+	void ResetStatistics();
+
+	inline std::vector<ModStats> const& GetStatistics() const
+	{
+		return mods_;
+	}
+
+	double TicksToMs(uint64_t ticks) const;
+
+private:
+	static constexpr uint32_t WindowBuckets = 8;
+
+	// Quota state of a mod, with the window converted to timestamp counter ticks
+	struct QuotaState
+	{
+		bool Active{ false };
+		bool Disable{ false };
+		uint64_t BudgetTicks{ 0 };
+		uint64_t WindowTicks{ 0 };
+		uint64_t BucketTicks{ 1 };
+		uint64_t Bucket{ 0 };
+		uint64_t LastWarning{ 0 };
+		std::array<uint64_t, WindowBuckets> Buckets{};
+	};
+
+	LuaAllocator const& allocator_;
+	std::vector<ModStats> mods_;
+	std::vector<QuotaState> quotaStates_;
+	std::unordered_map<STDString, uint32_t> owners_;
+	std::unordered_map<STDString, Quota> quotas_;
+	std::optional<Quota> defaultQuota_;
+
+	uint32_t current_{ NoOwner };
+	std::vector<uint32_t> ownerStack_;
+	uint64_t lastSwitch_{ 0 };
+	uint64_t lastAllocatedBytes_{ 0 };
+	uint64_t lastAllocations_{ 0 };
+
+	void Charge(uint64_t now);
+	bool CheckQuota(uint32_t owner, uint64_t now);
+	void ApplyQuota(uint32_t owner);
+};
+
+END_NS()
@@ -1,6 +1,7 @@
 local _G = _G
 
-Ext._Internal = {}
+-- Native internals are registered before the builtin library is loaded
+Ext._Internal = Ext._Internal or {}
 local _I = Ext._Internal
 
 _I._LoadedFiles = {}
@@ -1,4 +1,6 @@
 local _I = Ext._Internal
+local ProfiledCall = _I._ProfiledCall
+local GetHandlerOwner = _I._GetHandlerOwner
 
 local SubscribableEvent = {}
 
@@ -22,6 +24,8 @@ function SubscribableEvent:Subscribe(handler, opts)
 
 	local sub = {
 		Handler = handler,
+		-- Mod the handler is attributed to by the profiler
+		Owner = GetHandlerOwner(handler),
 		Index = index,
 		Priority = opts.Priority or 100,
 		Once = opts.Once or false,
@@ -126,12 +130,12 @@ function SubscribableEvent:Throw(event)
 			break
 		end
 
-        local ok, result = xpcall(cur.Handler, debug.traceback, event)
+        local ok, result, overQuota = ProfiledCall(cur.Owner, cur.Handler, event)
         if not ok then
             Ext.Utils.PrintError("Error while dispatching event " .. self.Name .. ": ", result)
         end
 
-		if cur.Once then
+		if cur.Once or overQuota then
 			local last = cur
 			cur = last.Next
 			self:RemoveNode(last)
@@ -110,6 +110,19 @@ function OsiDatabase:Get(...) end
 --- If the parameter is nil, the column is not filtered (equivalent to passing _ in Osiris). If the parameter is not nil, only rows with matching values will be deleted. 
 --- @vararg OsirisValue|nil
 function OsiDatabase:Delete(...) end
+--- Inserts multiple rows into the database in one call; each row is a table with one value per column.  
+--- The database is looked up by the number of columns in the first row (or by `arity`, if specified).  
+--- Rows are inserted in order; if a row is invalid, rows before it remain inserted.
+--- @param rows table<integer,table<integer,OsirisValue>>
+--- @param arity integer?
+--- @return integer Number of rows processed
+function OsiDatabase:InsertMany(rows, arity) end
+--- Deletes multiple rows from the database in one call. Each row is a filter like the parameters of Delete; nil columns are not filtered.  
+--- Since nil columns at the end of a row don't count towards its length, pass `arity` when the first row ends with a nil column.
+--- @param rows table<integer,table<integer,OsirisValue|nil>>
+--- @param arity integer?
+--- @return integer Number of rows processed
+function OsiDatabase:DeleteMany(rows, arity) end
 
 --- @alias OsiFunction fun(...:OsirisValue):OsirisValue|nil
 --- @alias OsiDynamic table<string, OsiFunction|OsiDatabase>
@@ -0,0 +1,91 @@
+local FilterAll = 0
+local FilterIndexed = 1
+local FilterNamed = 2
+
+function TestDebuggerVariablePaging()
+    local tbl = {}
+    for i=1,100 do
+        tbl[i] = i * 2
+    end
+    tbl.a = 1
+    tbl.b = 2
+    tbl.c = 3
+
+    -- Count probe doesn't return children
+    local vars = Ext._Internal._GetDebuggerVariables(tbl, 0, 0, FilterAll, true)
+    AssertEquals(vars.TotalCount, 103)
+    AssertEquals(#vars.Keys, 0)
+
+    -- Page of the sequence part
+    vars = Ext._Internal._GetDebuggerVariables(tbl, 10, 5, FilterIndexed)
+    AssertEquals(vars.TotalCount, 100)
+    AssertEquals(vars.Keys, {11, 12, 13, 14, 15})
+
+    -- Named children only
+    vars = Ext._Internal._GetDebuggerVariables(tbl, 0, 0, FilterNamed)
+    AssertEquals(vars.TotalCount, 3)
+    AssertEquals(#vars.Keys, 3)
+
+    -- Page spanning the sequence and the named part
+    vars = Ext._Internal._GetDebuggerVariables(tbl, 98, 4, FilterAll)
+    AssertEquals(vars.TotalCount, 103)
+    AssertEquals(#vars.Keys, 4)
+    AssertEquals(vars.Keys[1], 99)
+    AssertEquals(vars.Keys[2], 100)
+
+    -- Page past the end
+    vars = Ext._Internal._GetDebuggerVariables(tbl, 200, 10, FilterAll)
+    AssertEquals(vars.TotalCount, 103)
+    AssertEquals(#vars.Keys, 0)
+end
+
+local function BusyHandler()
+    local start = Ext.Utils.MonotonicTime()
+    while Ext.Utils.MonotonicTime() - start < 5 do end
+end
+
+function TestModProfile()
+    -- Handlers defined in builtin scripts are attributed to "builtin"
+    local owner = Ext._Internal._GetHandlerOwner(BusyHandler)
+    -- Callable tables are attributed to the owner of their __call metamethod
+    local callable = setmetatable({}, {__call = BusyHandler})
+    AssertEquals(Ext._Internal._GetHandlerOwner(callable), owner)
+
+    Ext.Debug.ResetModProfile()
+    local ok, err, overQuota = Ext._Internal._ProfiledCall(owner, BusyHandler)
+    AssertEquals(ok, true)
+    AssertEquals(overQuota, false)
+
+    local profile = Ext.Debug.GetModProfile().builtin
+    AssertEquals(profile.Calls, 1)
+    Assert(profile.TimeMs >= 4)
+    AssertEquals(profile.QuotaExceeded, 0)
+
+    -- Errors are reported without raising
+    ok, err, overQuota = Ext._Internal._ProfiledCall(owner, function () error("Test error") end)
+    AssertEquals(ok, false)
+    Assert(err ~= nil)
+end
+
+function TestModQuota()
+    local owner = Ext._Internal._GetHandlerOwner(BusyHandler)
+    Ext.Debug.ResetModProfile()
+
+    Ext.Debug.SetModQuota("builtin", 1, 1000, true)
+    local ok, err, overQuota = Ext._Internal._ProfiledCall(owner, BusyHandler)
+    Ext.Debug.SetModQuota("builtin", nil)
+
+    AssertEquals(ok, true)
+    AssertEquals(overQuota, true)
+    AssertEquals(Ext.Debug.GetModProfile().builtin.QuotaExceeded, 1)
+
+    -- Removing the quota stops enforcement
+    ok, err, overQuota = Ext._Internal._ProfiledCall(owner, BusyHandler)
+    AssertEquals(overQuota, false)
+end
+
+RegisterTests("Debug", {
+    "TestDebuggerVariablePaging",
+    "TestModProfile",
+    "TestModQuota"
+})
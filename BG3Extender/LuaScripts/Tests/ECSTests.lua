@@ -51,9 +51,46 @@ function TestECSFunctions()
     -- GetSalt and GetIndex have no deterministic outputs
 end
 
+function TestECSHandleSet()
+    local ent = Ext.Entity.Get(GUID_LAEZEL)
+    local entities = Ext.Entity.GetAllEntitiesWithComponent("DisplayName")
+
+    local set = Ext.Utils.CreateHandleSet(entities)
+    AssertEquals(#set, #entities)
+    AssertEquals(set:Contains(ent), true)
+    AssertEquals(set:Add(ent), false)
+    AssertEquals(set:Remove(ent), true)
+    AssertEquals(set:Contains(ent), false)
+    AssertEquals(#set, #entities - 1)
+
+    local count = 0
+    for handle,_ in pairs(set) do
+        Assert(handle ~= ent)
+        count = count + 1
+    end
+    AssertEquals(count, #set)
+
+    set:Intersect({ent, entities[1]})
+    AssertEquals(#set, entities[1] == ent and 0 or 1)
+    set:Union({ent})
+    AssertEquals(set:Contains(ent), true)
+
+    local map = Ext.Utils.CreateHandleMap()
+    for i,handle in ipairs(entities) do
+        map:Set(handle, i)
+    end
+    AssertEquals(#map, #entities)
+    map:Remove(entities[1])
+    AssertEquals(map:Get(entities[1]), nil)
+    for i = 2,#entities do
+        AssertEquals(map:Get(entities[i]), i)
+    end
+end
+
 RegisterTests("ECS", {
     "TestECSFetch",
     "TestECSComponents",
     "TestECSFunctions",
-    "TestECSReplication"
+    "TestECSReplication",
+    "TestECSHandleSet"
 })
@@ -13,6 +13,48 @@ function TestModInfo()
     AssertEquals(shared.Info.ModuleUUID, "ed539163-bb70-431b-96a7-f5b2eda5376b")
 end
 
+function TestLoadOrder()
+    local loadOrder = Ext.Mod.GetLoadOrder()
+    Assert(#loadOrder > 0)
+    for i,uuid in ipairs(loadOrder) do
+        AssertEquals(Ext.Mod.IsModLoaded(uuid), true)
+        AssertEquals(Ext.Mod.GetMod(uuid).Info.ModuleUUID, uuid)
+    end
+end
+
+function TestLoadOrderChangedInPlace()
+    local modules = Ext.Mod.GetModManager().BaseModule.LoadOrderedModules
+    Assert(#modules >= 2)
+    local first = modules[#modules - 1].Info.ModuleUUID
+    local second = modules[#modules].Info.ModuleUUID
+    local missing = "01010101-0202-0303-0404-050505050505"
+    -- Build the index before modifying the load order
+    AssertEquals(Ext.Mod.IsModLoaded(missing), false)
+
+    local ok, err = pcall(function ()
+        -- Swap the last two mods
+        modules[#modules - 1].Info.ModuleUUID = second
+        modules[#modules].Info.ModuleUUID = first
+        local loadOrder = Ext.Mod.GetLoadOrder()
+        AssertEquals(loadOrder[#loadOrder - 1], second)
+        AssertEquals(loadOrder[#loadOrder], first)
+        AssertEquals(Ext.Mod.GetMod(first).Info.ModuleUUID, first)
+        AssertEquals(Ext.Mod.GetMod(second).Info.ModuleUUID, second)
+
+        -- Replace a mod with one that wasn't present when the index was built
+        modules[#modules].Info.ModuleUUID = missing
+        AssertEquals(Ext.Mod.IsModLoaded(missing), true)
+        AssertEquals(Ext.Mod.IsModLoaded(first), false)
+    end)
+
+    modules[#modules - 1].Info.ModuleUUID = first
+    modules[#modules].Info.ModuleUUID = second
+    if not ok then error(err) end
+
+    AssertEquals(Ext.Mod.IsModLoaded(missing), false)
+    AssertEquals(Ext.Mod.GetMod(second).Info.ModuleUUID, second)
+end
+
 function TestBaseMod()
     local gustav = Ext.Mod.GetBaseMod()
     AssertEquals(gustav.Info.ModuleUUID, "28ac9ce2-2aba-8cda-b3b5-6e922f71b6b8")
@@ -26,6 +68,8 @@ end
 RegisterTests("Mod", {
     "TestModLoaded",
     "TestModInfo",
+    "TestLoadOrder",
+    "TestLoadOrderChangedInPlace",
     "TestBaseMod",
     "TestModManager"
 })
@@ -41,6 +41,41 @@ function TestOsirisDBSubscribers()
     AssertEquals(afterDeleteOk, true)
 end
 
+function TestOsirisDBInsertDeleteMany()
+    local host = Osi.GetHostCharacter()
+    local wasPlayer = #Osi.DB_Players:Get(host) > 0
+    Osi.DB_Players:Delete(host)
+    AssertEquals(#Osi.DB_Players:Get(host), 0)
+
+    AssertEquals(Osi.DB_Players:InsertMany({{host}}), 1)
+    AssertEquals(#Osi.DB_Players:Get(host), 1)
+
+    AssertEquals(Osi.DB_Players:DeleteMany({{host}}), 1)
+    AssertEquals(#Osi.DB_Players:Get(host), 0)
+
+    AssertEquals(Osi.DB_Players:InsertMany({}), 0)
+    if wasPlayer then
+        Osi.DB_Players(host)
+    end
+end
+
+function TestOsirisDBInsertDeleteManyRows()
+    local players = Osi.DB_Players:Get(nil)
+    Assert(#players > 0)
+
+    -- Wildcard delete; the arity can't be taken from a row that only has nil columns
+    AssertEquals(Osi.DB_Players:DeleteMany({{nil}}, 1), 1)
+    AssertEquals(#Osi.DB_Players:Get(nil), 0)
+
+    -- Multi-row insert; the duplicate row makes sure there's more than one row even with a single player
+    local rows = {players[1]}
+    for i,player in ipairs(players) do
+        table.insert(rows, player)
+    end
+    AssertEquals(Osi.DB_Players:InsertMany(rows), #players + 1)
+    AssertEquals(#Osi.DB_Players:Get(nil), #players)
+end
+
 function TestOsirisUserQuerySubscribers()
     local regOk = false
     local regOk2 = false
@@ -58,5 +93,7 @@ end
 RegisterTests("Stats", {
     "TestOsirisCallSubscribers",
     "TestOsirisDBSubscribers",
+    "TestOsirisDBInsertDeleteMany",
+    "TestOsirisDBInsertDeleteManyRows",
     "TestOsirisUserQuerySubscribers"
 })
@@ -3,6 +3,7 @@ Ext.Utils.Include(nil, "builtin://Tests/ModTests.lua")
 Ext.Utils.Include(nil, "builtin://Tests/StaticDataTests.lua")
 Ext.Utils.Include(nil, "builtin://Tests/StatTests.lua")
 Ext.Utils.Include(nil, "builtin://Tests/ECSTests.lua")
+Ext.Utils.Include(nil, "builtin://Tests/DebugTests.lua")
 --Ext.Utils.Include(nil, "builtin://Tests/ResourceTests.lua")
 --Ext.Utils.Include(nil, "builtin://Tests/CharacterTests.lua")
 --Ext.Utils.Include(nil, "builtin://Tests/CharacterComponentTests.lua")
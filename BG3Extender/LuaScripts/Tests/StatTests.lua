@@ -170,7 +170,28 @@ function TestStatAttributeReassignment()
     end
 end
 
+-- Tests if type-filtered stat enumeration covers each stats entry exactly once
+function TestGetStatsByType()
+    local seen = {}
+    local total = 0
+    for i,modifierList in ipairs(Ext.Stats.GetStatsManager().ModifierLists.Primitives) do
+        for j,statName in ipairs(Ext.Stats.GetStats(modifierList.Name)) do
+            AssertEquals(seen[statName], nil)
+            seen[statName] = modifierList.Name
+            total = total + 1
+        end
+    end
+
+    AssertEquals(total, #Ext.Stats.GetStats())
+
+    local shared = "ed539163-bb70-431b-96a7-f5b2eda5376b"
+    for i,statName in ipairs(Ext.Stats.GetStatsLoadedBefore(shared, "SpellData")) do
+        AssertEquals(seen[statName], "SpellData")
+    end
+end
+
 RegisterTests("Stats", {
     "TestStatAttributes",
-    "TestStatAttributeReassignment"
+    "TestStatAttributeReassignment",
+    "TestGetStatsByType"
 })
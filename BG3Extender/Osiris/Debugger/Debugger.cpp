@@ -312,7 +312,7 @@ namespace bg3se::osidbg
 		messageHandler_.SetDebugger(this);
 
 		auto wrappers = gExtender->GetServer().Osiris().GetVMTWrappers();
-		wrappers->DebuggerAttachment = this;
+		wrappers->SetDebuggerAttachment(this);
 		DEBUG("Debugger::Debugger(): Attached to story");
 	}
 
@@ -324,7 +324,7 @@ namespace bg3se::osidbg
 
 		auto wrappers = gExtender->GetServer().Osiris().GetVMTWrappers();
 		if (wrappers) {
-			wrappers->DebuggerAttachment = nullptr;
+			wrappers->SetDebuggerAttachment(nullptr);
 		}
 	}
 
@@ -44,17 +44,9 @@ namespace bg3se::esv
 				return;
 			}
 
-			auto mod = args[0].String;
-			auto func = args[1].String;
-			auto numArgs = args.Count() - 2;
-			std::vector<OsiArgumentValue> luaArgs;
-			luaArgs.resize(numArgs);
-
-			for (uint32_t i = 0; i < numArgs; i++) {
-				luaArgs[i] = args[i + 2];
-			}
-
-			lua->Call(mod, func, luaArgs);
+			auto mod = args.Value.String;
+			auto func = args.NextParam->Value.String;
+			lua->Call(mod, func, args.NextParam->NextParam);
 		}
 
 		char const * QueryArgNames[10] = {
@@ -78,6 +70,28 @@ namespace bg3se::esv
 			"Out5"
 		};
 
+		// Parameter types are left empty; the query bridge uses the types of the values passed by Osiris
+		template <uint32_t TInParams>
+		std::vector<CustomFunctionParam> const& GetModQuerySignature(uint32_t numOutParams)
+		{
+			static std::array<std::vector<CustomFunctionParam>, 6> signatures = []() {
+				std::array<std::vector<CustomFunctionParam>, 6> sigs;
+				for (uint32_t out = 0; out < sigs.size(); out++) {
+					for (uint32_t i = 0; i < TInParams; i++) {
+						sigs[out].push_back(CustomFunctionParam{ QueryArgNames[i], ValueType::None, FunctionArgumentDirection::In });
+					}
+
+					for (uint32_t i = 0; i < out; i++) {
+						sigs[out].push_back(CustomFunctionParam{ QueryOutArgNames[i], ValueType::None, FunctionArgumentDirection::Out });
+					}
+				}
+
+				return sigs;
+			}();
+
+			return signatures[numOutParams];
+		}
+
 		template <uint32_t TInParams>
 		bool OsiLuaModQuery(OsiArgumentDesc & args)
 		{
@@ -87,25 +101,10 @@ namespace bg3se::esv
 				return false;
 			}
 
-			auto mod = args[0].String;
-			auto func = args[1].String;
-			auto numArgs = args.Count() - 2;
-
-			std::vector<CustomFunctionParam> signature;
-			signature.reserve(numArgs);
-			for (uint32_t i = 0; i < TInParams; i++) {
-				signature.push_back(CustomFunctionParam{
-					QueryArgNames[i], args[i + 2].TypeId, FunctionArgumentDirection::In
-				});
-			}
-
-			for (uint32_t i = 0; i < numArgs - TInParams; i++) {
-				signature.push_back(CustomFunctionParam{
-					QueryOutArgNames[i], args[i + TInParams + 2].TypeId, FunctionArgumentDirection::Out
-				});
-			}
-
-			return lua->Query(mod, func, nullptr, signature, *args.NextParam->NextParam);
+			auto mod = args.Value.String;
+			auto func = args.NextParam->Value.String;
+			auto numOutParams = args.Count() - 2 - TInParams;
+			return lua->Query(mod, func, nullptr, GetModQuerySignature<TInParams>(numOutParams), *args.NextParam->NextParam);
 		}
 	}
 
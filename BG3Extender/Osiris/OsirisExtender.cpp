@@ -79,9 +79,13 @@ void OsirisExtender::OnBaseModuleLoadedServer()
 
 void OsirisExtender::HookNodeVMTs()
 {
+	// Node VMTs live in the Osiris DLL, so the wrappers only need to be created once;
+	// the wrapped entries are swapped in when the debugger or Lua callbacks attach
+	if (nodeVmtWrappers_) return;
+
 	if (wrappers_.ResolveNodeVMTs()) {
-		nodeVmtWrappers_.reset();
 		nodeVmtWrappers_ = std::make_unique<NodeVMTWrappers>(wrappers_.VMTs);
+		nodeVmtWrappers_->SetOsirisCallbacksAttachment(osirisCallbacksAttachment_);
 	}
 }
 
@@ -388,7 +392,7 @@ void OsirisExtender::BindCallbackManager(esv::lua::OsirisCallbackManager* mgr)
 {
 	osirisCallbacksAttachment_ = mgr;
 	if (nodeVmtWrappers_) {
-		nodeVmtWrappers_->OsirisCallbacksAttachment = mgr;
+		nodeVmtWrappers_->SetOsirisCallbacksAttachment(mgr);
 	}
 }
 
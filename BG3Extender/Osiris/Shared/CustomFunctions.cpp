@@ -459,7 +459,7 @@ void CustomFunctionManager::PreProcessStory(wchar_t const * path)
 		}
 	}
 
-	if (esv::ExtensionState::Get().HasFeatureFlag("Preprocessor")) {
+	if (esv::ExtensionState::Get().HasFeatureFlag(ExtensionFeatureFlag::Preprocessor)) {
 		PreProcessStory(original, postProcessed);
 	} else {
 		postProcessed = original;
@@ -733,7 +733,7 @@ void CustomFunctionInjector::OnCloseHandle(HANDLE hFile, BOOL bSucceeded)
 {
 	if (bSucceeded && !extendingStory_) {
 		if (storyHeaderFile_ != NULL && hFile == storyHeaderFile_) {
-			if (esv::ExtensionState::Get().HasFeatureFlag("Osiris")) {
+			if (esv::ExtensionState::Get().HasFeatureFlag(ExtensionFeatureFlag::Osiris)) {
 				ExtendStoryHeader(storyHeaderPath_);
 			}
 
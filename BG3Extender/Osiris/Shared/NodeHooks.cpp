@@ -29,41 +29,25 @@ namespace bg3se
 
 	NodeVMTWrappers * gNodeVMTWrappers{ nullptr };
 
-	NodeVMTWrapper::NodeVMTWrapper(NodeVMT * vmt, NodeWrapOptions & options)
-		: vmt_(vmt), options_(options)
-	{
-		originalVmt_ = *vmt_;
+	NodeVMTWrapper::NodeVMTWrapper(NodeVMT * vmt, NodeWrapOptions const & options, NodeVMT const & wrappedVmt)
+		: vmt_(vmt), options_(options), originalVmt_(*vmt), wrappedVmt_(wrappedVmt)
+	{}
 
+	NodeVMTWrapper::~NodeVMTWrapper()
+	{
 		ROWriteAnchor<NodeVMT> _(vmt_);
-		if (options_.WrapIsValid) {
-			vmt_->IsValid = &s_WrappedIsValid;
-		}
-
-		if (options_.WrapPushDownTuple) {
-			vmt_->PushDownTuple = &s_WrappedPushDownTuple;
-		}
-
-		if (options_.WrapPushDownTupleDelete) {
-			vmt_->PushDownTupleDelete = &s_WrappedPushDownTupleDelete;
-		}
-
-		if (options_.WrapInsertTuple) {
-			vmt_->InsertTuple = &s_WrappedInsertTuple;
-		}
-
-		if (options_.WrapDeleteTuple) {
-			vmt_->DeleteTuple = &s_WrappedDeleteTuple;
-		}
-
-		if (options_.WrapCallQuery) {
-			vmt_->CallQuery = &s_WrappedCallQuery;
-		}
+		*vmt_ = originalVmt_;
 	}
 
-	NodeVMTWrapper::~NodeVMTWrapper()
+	void NodeVMTWrapper::Apply(NodeWrapOptions const & mask)
 	{
 		ROWriteAnchor<NodeVMT> _(vmt_);
-		*vmt_ = originalVmt_;
+		vmt_->IsValid = (options_.WrapIsValid && mask.WrapIsValid) ? wrappedVmt_.IsValid : originalVmt_.IsValid;
+		vmt_->PushDownTuple = (options_.WrapPushDownTuple && mask.WrapPushDownTuple) ? wrappedVmt_.PushDownTuple : originalVmt_.PushDownTuple;
+		vmt_->PushDownTupleDelete = (options_.WrapPushDownTupleDelete && mask.WrapPushDownTupleDelete) ? wrappedVmt_.PushDownTupleDelete : originalVmt_.PushDownTupleDelete;
+		vmt_->InsertTuple = (options_.WrapInsertTuple && mask.WrapInsertTuple) ? wrappedVmt_.InsertTuple : originalVmt_.InsertTuple;
+		vmt_->DeleteTuple = (options_.WrapDeleteTuple && mask.WrapDeleteTuple) ? wrappedVmt_.DeleteTuple : originalVmt_.DeleteTuple;
+		vmt_->CallQuery = (options_.WrapCallQuery && mask.WrapCallQuery) ? wrappedVmt_.CallQuery : originalVmt_.CallQuery;
 	}
 
 	bool NodeVMTWrapper::WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter)
@@ -96,34 +80,53 @@ namespace bg3se
 		return originalVmt_.CallQuery(node, args);
 	}
 
+	template <NodeType Type>
+	NodeVMT NodeVMTWrapper::MakeWrappedVMT()
+	{
+		NodeVMT vmt{};
+		vmt.IsValid = &s_WrappedIsValid<Type>;
+		vmt.PushDownTuple = &s_WrappedPushDownTuple<Type>;
+		vmt.PushDownTupleDelete = &s_WrappedPushDownTupleDelete<Type>;
+		vmt.InsertTuple = &s_WrappedInsertTuple<Type>;
+		vmt.DeleteTuple = &s_WrappedDeleteTuple<Type>;
+		vmt.CallQuery = &s_WrappedCallQuery<Type>;
+		return vmt;
+	}
+
+	template <NodeType Type>
 	bool NodeVMTWrapper::s_WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter)
 	{
-		return gNodeVMTWrappers->WrappedIsValid(node, tuple, adapter);
+		return gNodeVMTWrappers->WrappedIsValid(Type, node, tuple, adapter);
 	}
 
+	template <NodeType Type>
 	void NodeVMTWrapper::s_WrappedPushDownTuple(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
 	{
-		gNodeVMTWrappers->WrappedPushDownTuple(node, tuple, adapter, which);
+		gNodeVMTWrappers->WrappedPushDownTuple(Type, node, tuple, adapter, which);
 	}
 
+	template <NodeType Type>
 	void NodeVMTWrapper::s_WrappedPushDownTupleDelete(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
 	{
-		gNodeVMTWrappers->WrappedPushDownTupleDelete(node, tuple, adapter, which);
+		gNodeVMTWrappers->WrappedPushDownTupleDelete(Type, node, tuple, adapter, which);
 	}
 
+	template <NodeType Type>
 	void NodeVMTWrapper::s_WrappedInsertTuple(Node * node, TuplePtrLL * tuple)
 	{
-		gNodeVMTWrappers->WrappedInsertTuple(node, tuple);
+		gNodeVMTWrappers->WrappedInsertTuple(Type, node, tuple);
 	}
 
+	template <NodeType Type>
 	void NodeVMTWrapper::s_WrappedDeleteTuple(Node * node, TuplePtrLL * tuple)
 	{
-		gNodeVMTWrappers->WrappedDeleteTuple(node, tuple);
+		gNodeVMTWrappers->WrappedDeleteTuple(Type, node, tuple);
 	}
 
+	template <NodeType Type>
 	bool NodeVMTWrapper::s_WrappedCallQuery(Node * node, OsiArgumentDesc * args)
 	{
-		return gNodeVMTWrappers->WrappedCallQuery(node, args);
+		return gNodeVMTWrappers->WrappedCallQuery(Type, node, args);
 	}
 
 	NodeWrapOptions VMTWrapOptions[(unsigned)NodeType::Max + 1] = {
@@ -139,15 +142,25 @@ namespace bg3se
 		{ true, false, false, false, false, false } // UserQuery
 	};
 
+	// Entries needed by each kind of attachment
+	NodeWrapOptions const NoWrapOptions{ false, false, false, false, false, false };
+	NodeWrapOptions const DebuggerWrapOptions{ true, true, true, true, true, true };
+	NodeWrapOptions const OsirisCallbackWrapOptions{ false, false, false, true, true, true };
+
 	NodeVMTWrappers::NodeVMTWrappers(NodeVMT ** vmts)
 		: vmts_(vmts)
 	{
 		assert(gNodeVMTWrappers == nullptr);
 		gNodeVMTWrappers = this;
-		for (unsigned i = 1; i < (unsigned)NodeType::Max + 1; i++) {
-			wrappers_[i] = std::make_unique<NodeVMTWrapper>(vmts_[i], VMTWrapOptions[i]);
-			vmtToTypeMap_[vmts[i]] = (NodeType)i;
-		}
+		AddWrapper<NodeType::Database>();
+		AddWrapper<NodeType::Proc>();
+		AddWrapper<NodeType::DivQuery>();
+		AddWrapper<NodeType::And>();
+		AddWrapper<NodeType::NotAnd>();
+		AddWrapper<NodeType::RelOp>();
+		AddWrapper<NodeType::Rule>();
+		AddWrapper<NodeType::InternalQuery>();
+		AddWrapper<NodeType::UserQuery>();
 	}
 
 	NodeVMTWrappers::~NodeVMTWrappers()
@@ -156,134 +169,165 @@ namespace bg3se
 		gNodeVMTWrappers = nullptr;
 	}
 
-	NodeType NodeVMTWrappers::GetType(Node * node)
+	template <NodeType Type>
+	void NodeVMTWrappers::AddWrapper()
 	{
-		NodeVMT * vfptr = *reinterpret_cast<NodeVMT **>(node);
-		auto typeIt = vmtToTypeMap_.find(vfptr);
-		if (typeIt == vmtToTypeMap_.end()) Fail("Called virtual method on a node that could not be identified");
-		return typeIt->second;
+		auto index = (unsigned)Type;
+		wrappers_[index] = std::make_unique<NodeVMTWrapper>(vmts_[index], VMTWrapOptions[index], NodeVMTWrapper::MakeWrappedVMT<Type>());
+	}
+
+	void NodeVMTWrappers::SetDebuggerAttachment(osidbg::Debugger* debugger)
+	{
+		debuggerAttachment_ = debugger;
+		UpdateWrappers();
 	}
 
-	NodeVMTWrapper & NodeVMTWrappers::GetWrapper(Node * node)
+	void NodeVMTWrappers::SetOsirisCallbacksAttachment(esv::lua::OsirisCallbackManager* callbacks)
 	{
-		NodeType type = GetType(node);
-		assert(type >= NodeType::Database && type <= NodeType::Max);
-		return *wrappers_[(unsigned)type].get();
+		osirisCallbacksAttachment_ = callbacks;
+		UpdateWrappers();
+	}
+
+	void NodeVMTWrappers::UpdateWrappers()
+	{
+		NodeWrapOptions const* mask = &NoWrapOptions;
+		if (debuggerAttachment_) {
+			mask = &DebuggerWrapOptions;
+		} else if (osirisCallbacksAttachment_) {
+			mask = &OsirisCallbackWrapOptions;
+		}
+
+		for (unsigned i = 1; i < (unsigned)NodeType::Max + 1; i++) {
+			wrappers_[i]->Apply(*mask);
+		}
+	}
+
+	NodeType NodeVMTWrappers::GetType(Node * node)
+	{
+		NodeVMT * vfptr = *reinterpret_cast<NodeVMT **>(node);
+		for (unsigned i = 1; i < (unsigned)NodeType::Max + 1; i++) {
+			if (vmts_[i] == vfptr) {
+				return (NodeType)i;
+			}
+		}
+
+		Fail("Called virtual method on a node that could not be identified");
+		return NodeType::None;
 	}
 
-	bool NodeVMTWrappers::WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter)
+	bool NodeVMTWrappers::WrappedIsValid(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->IsValidPreHook(node, tuple, adapter);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->IsValidPreHook(node, tuple, adapter);
 		}
 
 		bool succeeded = wrapper.WrappedIsValid(node, tuple, adapter);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->IsValidPostHook(node, tuple, adapter, succeeded);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->IsValidPostHook(node, tuple, adapter, succeeded);
 		}
 
 		return succeeded;
 	}
 
-	void NodeVMTWrappers::WrappedPushDownTuple(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
+	void NodeVMTWrappers::WrappedPushDownTuple(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->PushDownPreHook(node, tuple, adapter, which, false);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->PushDownPreHook(node, tuple, adapter, which, false);
 		}
 
 		wrapper.WrappedPushDownTuple(node, tuple, adapter, which);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->PushDownPostHook(node, tuple, adapter, which, false);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->PushDownPostHook(node, tuple, adapter, which, false);
 		}
 	}
 
-	void NodeVMTWrappers::WrappedPushDownTupleDelete(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
+	void NodeVMTWrappers::WrappedPushDownTupleDelete(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->PushDownPreHook(node, tuple, adapter, which, true);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->PushDownPreHook(node, tuple, adapter, which, true);
 		}
 
 		wrapper.WrappedPushDownTupleDelete(node, tuple, adapter, which);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->PushDownPostHook(node, tuple, adapter, which, true);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->PushDownPostHook(node, tuple, adapter, which, true);
 		}
 	}
 
-	void NodeVMTWrappers::WrappedInsertTuple(Node * node, TuplePtrLL * tuple)
+	void NodeVMTWrappers::WrappedInsertTuple(NodeType type, Node * node, TuplePtrLL * tuple)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->InsertPreHook(node, tuple, false);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->InsertPreHook(node, tuple, false);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->InsertPreHook(node, tuple, false);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->InsertPreHook(node, tuple, false);
 		}
 
 		wrapper.WrappedInsertTuple(node, tuple);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->InsertPostHook(node, tuple, false);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->InsertPostHook(node, tuple, false);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->InsertPostHook(node, tuple, false);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->InsertPostHook(node, tuple, false);
 		}
 	}
 
-	void NodeVMTWrappers::WrappedDeleteTuple(Node * node, TuplePtrLL * tuple)
+	void NodeVMTWrappers::WrappedDeleteTuple(NodeType type, Node * node, TuplePtrLL * tuple)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->InsertPreHook(node, tuple, true);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->InsertPreHook(node, tuple, true);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->InsertPreHook(node, tuple, true);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->InsertPreHook(node, tuple, true);
 		}
 
 		wrapper.WrappedDeleteTuple(node, tuple);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->InsertPostHook(node, tuple, true);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->InsertPostHook(node, tuple, true);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->InsertPostHook(node, tuple, true);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->InsertPostHook(node, tuple, true);
 		}
 	}
 
-	bool NodeVMTWrappers::WrappedCallQuery(Node * node, OsiArgumentDesc * args)
+	bool NodeVMTWrappers::WrappedCallQuery(NodeType type, Node * node, OsiArgumentDesc * args)
 	{
-		auto & wrapper = GetWrapper(node);
+		auto & wrapper = *wrappers_[(unsigned)type];
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->CallQueryPreHook(node, args);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->CallQueryPreHook(node, args);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->CallQueryPreHook(node, args);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->CallQueryPreHook(node, args);
 		}
 
 		bool succeeded = wrapper.WrappedCallQuery(node, args);
 
-		if (DebuggerAttachment) {
-			DebuggerAttachment->CallQueryPostHook(node, args, succeeded);
+		if (debuggerAttachment_) {
+			debuggerAttachment_->CallQueryPostHook(node, args, succeeded);
 		}
 
-		if (OsirisCallbacksAttachment) {
-			OsirisCallbacksAttachment->CallQueryPostHook(node, args, succeeded);
+		if (osirisCallbacksAttachment_) {
+			osirisCallbacksAttachment_->CallQueryPostHook(node, args, succeeded);
 		}
 
 		return succeeded;
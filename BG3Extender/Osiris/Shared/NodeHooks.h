@@ -1,7 +1,6 @@
 #pragma once
 
 #include <GameDefinitions/Osiris.h>
-#include <unordered_map>
 #include <functional>
 
 namespace bg3se
@@ -16,12 +15,24 @@ namespace bg3se
 		bool WrapCallQuery;
 	};
 
+	// Wrapped VMT entries of a single node type.
+	// The wrapped entries are only written to the VMT while a hook is attached; otherwise the VMT
+	// holds the original functions, so story execution doesn't go through the wrappers at all.
 	class NodeVMTWrapper
 	{
 	public:
-		NodeVMTWrapper(NodeVMT * vmt, NodeWrapOptions & options);
+		NodeVMTWrapper(NodeVMT * vmt, NodeWrapOptions const & options, NodeVMT const & wrappedVmt);
 		~NodeVMTWrapper();
 
+		// Installs the wrapped entries that are enabled both by the node type options and the mask,
+		// and restores the original entries for the rest
+		void Apply(NodeWrapOptions const & mask);
+
+		inline NodeVMT * GetVMT() const
+		{
+			return vmt_;
+		}
+
 		bool WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter);
 		void WrappedPushDownTuple(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
 		void WrappedPushDownTupleDelete(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
@@ -29,17 +40,29 @@ namespace bg3se
 		void WrappedDeleteTuple(Node * node, TuplePtrLL * tuple);
 		bool WrappedCallQuery(Node * node, OsiArgumentDesc * args);
 
+		// Each node type gets its own instantiation of the static wrappers, so the wrapper
+		// for the node is known without looking up the VMT of the node
+		template <NodeType Type>
+		static NodeVMT MakeWrappedVMT();
+
+		template <NodeType Type>
 		static bool s_WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter);
+		template <NodeType Type>
 		static void s_WrappedPushDownTuple(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
+		template <NodeType Type>
 		static void s_WrappedPushDownTupleDelete(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
+		template <NodeType Type>
 		static void s_WrappedInsertTuple(Node * node, TuplePtrLL * tuple);
+		template <NodeType Type>
 		static void s_WrappedDeleteTuple(Node * node, TuplePtrLL * tuple);
+		template <NodeType Type>
 		static bool s_WrappedCallQuery(Node * node, OsiArgumentDesc * args);
 
 	private:
 		NodeVMT * vmt_;
-		NodeWrapOptions & options_;
+		NodeWrapOptions const & options_;
 		NodeVMT originalVmt_;
+		NodeVMT wrappedVmt_;
 	};
 
 	class NodeVMTWrappers : Noncopyable<NodeVMTWrappers>
@@ -48,22 +71,37 @@ namespace bg3se
 		NodeVMTWrappers(NodeVMT ** vmts);
 		~NodeVMTWrappers();
 
-		bool WrappedIsValid(Node * node, VirtTupleLL * tuple, AdapterRef * adapter);
-		void WrappedPushDownTuple(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
-		void WrappedPushDownTupleDelete(Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
-		void WrappedInsertTuple(Node * node, TuplePtrLL * tuple);
-		void WrappedDeleteTuple(Node * node, TuplePtrLL * tuple);
-		bool WrappedCallQuery(Node * node, OsiArgumentDesc * args);
+		bool WrappedIsValid(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter);
+		void WrappedPushDownTuple(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
+		void WrappedPushDownTupleDelete(NodeType type, Node * node, VirtTupleLL * tuple, AdapterRef * adapter, EntryPoint which);
+		void WrappedInsertTuple(NodeType type, Node * node, TuplePtrLL * tuple);
+		void WrappedDeleteTuple(NodeType type, Node * node, TuplePtrLL * tuple);
+		bool WrappedCallQuery(NodeType type, Node * node, OsiArgumentDesc * args);
 
-		osidbg::Debugger* DebuggerAttachment{ nullptr };
-		esv::lua::OsirisCallbackManager* OsirisCallbacksAttachment{ nullptr };
+		inline osidbg::Debugger* GetDebuggerAttachment() const
+		{
+			return debuggerAttachment_;
+		}
+
+		inline esv::lua::OsirisCallbackManager* GetOsirisCallbacksAttachment() const
+		{
+			return osirisCallbacksAttachment_;
+		}
+
+		// Attaching or detaching a listener swaps the wrapped VMT entries in or out
+		void SetDebuggerAttachment(osidbg::Debugger* debugger);
+		void SetOsirisCallbacksAttachment(esv::lua::OsirisCallbackManager* callbacks);
 
 		NodeType GetType(Node * node);
-		NodeVMTWrapper & GetWrapper(Node * node);
 
 	private:
 		NodeVMT ** vmts_;
 		std::unique_ptr<NodeVMTWrapper> wrappers_[(unsigned)NodeType::Max + 1];
-		std::unordered_map<NodeVMT *, NodeType> vmtToTypeMap_;
+		osidbg::Debugger* debuggerAttachment_{ nullptr };
+		esv::lua::OsirisCallbackManager* osirisCallbacksAttachment_{ nullptr };
+
+		template <NodeType Type>
+		void AddWrapper();
+		void UpdateWrappers();
 	};
 }
@@ -234,14 +234,18 @@ namespace NSE.DebuggerFrontend
             return Send(msg);
         }
 
-        public UInt32 SendGetVariables(BackendVariableReference vref)
+        public UInt32 SendGetVariables(BackendVariableReference vref, int start = 0, int count = 0,
+            DbgGetVariables.Types.Filter filter = DbgGetVariables.Types.Filter.All)
         {
             var eval = new DbgGetVariables
             {
                 Context = vref.Context,
                 VariableRef = vref.VariableRef,
                 Frame = vref.Frame,
-                Local = vref.Local
+                Local = vref.Local,
+                Start = start,
+                Count = count,
+                Filter = filter
             };
 
             if (vref.Keys != null)
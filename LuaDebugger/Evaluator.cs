@@ -153,23 +153,34 @@ namespace NSE.DebuggerFrontend
             }
         }
 
-        private void OnVariablesReceived(DAPRequest request, DAPVariablesRequest msg, ThreadState state, BkGetVariablesResponse response)
+        private DbgGetVariables.Types.Filter DAPFilterToDbg(string filter)
         {
-            int startIndex = msg.start == null ? 0 : (int)msg.start;
-            int numVars = (msg.count == null || msg.count == 0) ? response.Result.Count : (int)msg.count;
-            int lastIndex = Math.Min(startIndex + numVars, response.Result.Count);
-            // TODO req.filter, format
+            switch (filter)
+            {
+                case "indexed": return DbgGetVariables.Types.Filter.Indexed;
+                case "named": return DbgGetVariables.Types.Filter.Named;
+                default: return DbgGetVariables.Types.Filter.All;
+            }
+        }
+
+        private void OnVariablesReceived(DAPRequest request, DAPVariablesRequest msg, ThreadState state, IEnumerable<MsgChildValue> results)
+        {
+            // TODO req.format
 
             var variables = new List<DAPVariable>();
-            for (var i = startIndex; i < startIndex + numVars; i++)
+            foreach (var variable in results)
             {
-                var variable = response.Result[i];
                 var dapVar = new DAPVariable
                 {
                     value = DbgValueToString(variable.Value),
                     type = variable.Value.TypeId.ToString()
                 };
 
+                if (variable.Value.IndexedCount > 0)
+                {
+                    dapVar.indexedVariables = variable.Value.IndexedCount;
+                }
+
                 if (variable.Type == MsgChildValue.Types.Type.Numeric)
                 {
                     dapVar.name = variable.Index.ToString();
@@ -222,12 +233,20 @@ namespace NSE.DebuggerFrontend
             {
                 if (status == StatusCode.Success)
                 {
-                    // Filter locals/upvalues based on requested scope type
-                    var results = response.Result.Where(result => ((result.Index >= 0) == (scopeIndex == 0))).ToList();
-                    response.Result.Clear();
-                    response.Result.AddRange(results);
+                    // Filter locals/upvalues based on requested scope type;
+                    // stack frames are small, so they're paged here instead of in the backend
+                    var results = response.Result.Where(result => ((result.Index >= 0) == (scopeIndex == 0)));
+                    int startIndex = msg.start ?? 0;
+                    if (msg.count != null && msg.count > 0)
+                    {
+                        results = results.Skip(startIndex).Take((int)msg.count);
+                    }
+                    else
+                    {
+                        results = results.Skip(startIndex);
+                    }
 
-                    OnVariablesReceived(request, msg, state, response);
+                    OnVariablesReceived(request, msg, state, results);
                 }
                 else if (status == StatusCode.EvalFailed && response != null)
                 {
@@ -254,12 +273,12 @@ namespace NSE.DebuggerFrontend
                 throw new RequestFailedException("Cannot fetch variables when thread is not stopped");
             }
 
-            uint seq = DAP.DbgCli.SendGetVariables(varRef);
+            uint seq = DAP.DbgCli.SendGetVariables(varRef, msg.start ?? 0, msg.count ?? 0, DAPFilterToDbg(msg.filter));
             PendingGetVariablesRequests.Add(seq, (uint replySeq, StatusCode status, BkGetVariablesResponse response) =>
             {
                 if (status == StatusCode.Success)
                 {
-                    OnVariablesReceived(request, msg, state, response);
+                    OnVariablesReceived(request, msg, state, response.Result);
                 }
                 else if (status == StatusCode.EvalFailed && response != null)
                 {
@@ -311,6 +330,10 @@ namespace NSE.DebuggerFrontend
             else
             {
                 evalResponse.result = DbgValueToString(response.Result);
+                if (response.Result.IndexedCount > 0)
+                {
+                    evalResponse.indexedVariables = response.Result.IndexedCount;
+                }
 
                 if (response.Result.Variables != null)
                 {